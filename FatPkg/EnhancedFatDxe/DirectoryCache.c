@@ -37,6 +37,10 @@ FatFreeODir (
     FatFreeDirEnt (DirEnt);
   }
 
+  if (ODir->LongNameHashTable != NULL) {
+    FreePool (ODir->LongNameHashTable);
+  }
+
   FreePool (ODir);
 }
 
@@ -63,6 +67,10 @@ FatAllocateODir (
     ODir->Signature = FAT_ODIR_SIGNATURE;
     InitializeListHead (&ODir->ChildList);
     ODir->CurrentCursor = &ODir->ChildList;
+    if (EFI_ERROR (FatAllocateHashTable (ODir, HASH_TABLE_SIZE))) {
+      FreePool (ODir);
+      ODir = NULL;
+    }
   }
 
   return ODir;
@@ -352,6 +352,100 @@ FatExchangeCachePage (
   return EFI_SUCCESS;
 }
 
+/**
+
+  Load the data cache page PageNo together with the pages that follow it on
+  the disk, with a single disk read.
+
+  The following pages are placed in the cache groups after the group of PageNo,
+  so prefetching stops at the last group and at the first group that still
+  holds dirty data. The dirty data of the group of PageNo itself must have been
+  written back by the caller.
+
+  @param  Volume                - FAT file system volume.
+  @param  PageNo                - The first PageNo to load.
+
+  @retval EFI_SUCCESS           - The cache pages are loaded successfully.
+  @return Others                - An error occurred when reading the disk.
+
+**/
+STATIC
+EFI_STATUS
+FatPrefetchDataCachePages (
+  IN FAT_VOLUME  *Volume,
+  IN UINTN       PageNo
+  )
+{
+  EFI_STATUS  Status;
+  DISK_CACHE  *DiskCache;
+  CACHE_TAG   *CacheTag;
+  UINTN       GroupNo;
+  UINTN       PageCount;
+  UINTN       PageSize;
+  UINTN       ReadSize;
+  UINTN       Index;
+  UINT64      EntryPos;
+  UINT64      MaxSize;
+  UINT8       PageAlignment;
+
+  DiskCache     = &Volume->DiskCache[CacheData];
+  GroupNo       = PageNo & DiskCache->GroupMask;
+  PageAlignment = DiskCache->PageAlignment;
+  PageSize      = (UINTN)1 << PageAlignment;
+
+  for (PageCount = 1; PageCount < FAT_DATACACHE_PREFETCH_PAGES; PageCount++) {
+    if (GroupNo + PageCount > DiskCache->GroupMask) {
+      break;
+    }
+
+    CacheTag = &DiskCache->CacheTag[GroupNo + PageCount];
+    if ((CacheTag->RealSize > 0) && CacheTag->Dirty) {
+      break;
+    }
+  }
+
+  EntryPos = DiskCache->BaseAddress + LShiftU64 (PageNo, PageAlignment);
+  ReadSize = PageCount << PageAlignment;
+  MaxSize  = DiskCache->LimitAddress - EntryPos;
+  if (MaxSize < ReadSize) {
+    ReadSize = (UINTN)MaxSize;
+  }
+
+  //
+  // The groups are overwritten even if the read fails, so drop them first.
+  //
+  for (Index = 0; Index < PageCount; Index++) {
+    DiskCache->CacheTag[GroupNo + Index].RealSize = 0;
+  }
+
+  Status = FatDiskIo (
+             Volume,
+             ReadDisk,
+             EntryPos,
+             ReadSize,
+             DiskCache->CacheBase + (GroupNo << PageAlignment),
+             NULL
+             );
+  if (EFI_ERROR (Status)) {
+    //
+    // Nothing was loaded, so stop treating the next access as sequential.
+    //
+    DiskCache->NextPageNo = MAX_UINTN;
+    return Status;
+  }
+
+  for (Index = 0; (Index < PageCount) && (ReadSize > 0); Index++) {
+    CacheTag = &DiskCache->CacheTag[GroupNo + Index];
+    ClearCacheTagDirtyState (CacheTag);
+    CacheTag->PageNo   = PageNo + Index;
+    CacheTag->RealSize = MIN (ReadSize, PageSize);
+    ReadSize          -= CacheTag->RealSize;
+  }
+
+  DiskCache->NextPageNo = PageNo + Index;
+  return EFI_SUCCESS;
+}
+
 /**
 
   Get one cache page by specified PageNo.
@@ -376,6 +470,7 @@ FatGetCachePage (
 {
   EFI_STATUS  Status;
   UINTN       OldPageNo;
+  BOOLEAN     PrefetchFailed;
 
   OldPageNo = CacheTag->PageNo;
   if ((CacheTag->RealSize > 0) && (OldPageNo == PageNo)) {
@@ -395,11 +490,30 @@ FatGetCachePage (
     }
   }
 
+  //
+  // A data cache miss on the page following the last one loaded is taken
+  // as sequential access, and the pages after it are read ahead. The read
+  // ahead may run into a bad cluster or past the end of the volume, so the
+  // page is loaded on its own if it fails.
+  //
+  PrefetchFailed = FALSE;
+  if ((CacheDataType == CacheData) && (PageNo == Volume->DiskCache[CacheData].NextPageNo)) {
+    Status = FatPrefetchDataCachePages (Volume, PageNo);
+    if (!EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    PrefetchFailed = TRUE;
+  }
+
   //
   // Load new data from disk;
   //
   CacheTag->PageNo = PageNo;
   Status           = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, NULL);
+  if (CacheDataType == CacheData) {
+    Volume->DiskCache[CacheData].NextPageNo = (EFI_ERROR (Status) || PrefetchFailed) ? MAX_UINTN : PageNo + 1;
+  }
 
   return Status;
 }
@@ -668,23 +782,43 @@ FatInitializeDiskCache (
     FatCacheGroupCount                 = FAT_FATCACHE_GROUP_MAX_COUNT;
     DiskCache[CacheFat].PageAlignment  = FAT_FATCACHE_PAGE_MAX_ALIGNMENT;
     DiskCache[CacheData].PageAlignment = FAT_DATACACHE_PAGE_MAX_ALIGNMENT;
+    //
+    // Grow the FAT cache towards holding the whole FAT of large volumes, so
+    // that walking cluster chains does not keep evicting FAT pages.
+    //
+    while ((FatCacheGroupCount < FAT_DATACACHE_GROUP_COUNT) &&
+           ((FatCacheGroupCount << FAT_FATCACHE_PAGE_MAX_ALIGNMENT) < Volume->FatSize))
+    {
+      FatCacheGroupCount <<= 1;
+    }
+  }
+
+  DataCacheSize = FAT_DATACACHE_GROUP_COUNT << DiskCache[CacheData].PageAlignment;
+  //
+  // Allocate the Fat Cache buffer, falling back to a smaller FAT cache
+  // when memory is short
+  //
+  while (TRUE) {
+    FatCacheSize = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
+    CacheBuffer  = AllocateZeroPool (FatCacheSize + DataCacheSize);
+    if (CacheBuffer != NULL) {
+      break;
+    }
+
+    if (FatCacheGroupCount <= FAT_FATCACHE_GROUP_MAX_COUNT) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    FatCacheGroupCount >>= 1;
   }
 
   DiskCache[CacheData].GroupMask    = FAT_DATACACHE_GROUP_COUNT - 1;
   DiskCache[CacheData].BaseAddress  = Volume->RootPos;
   DiskCache[CacheData].LimitAddress = Volume->VolumeSize;
+  DiskCache[CacheData].NextPageNo   = MAX_UINTN;
   DiskCache[CacheFat].GroupMask     = FatCacheGroupCount - 1;
   DiskCache[CacheFat].BaseAddress   = Volume->FatPos;
   DiskCache[CacheFat].LimitAddress  = Volume->FatPos + Volume->FatSize;
-  FatCacheSize                      = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
-  DataCacheSize                     = FAT_DATACACHE_GROUP_COUNT << DiskCache[CacheData].PageAlignment;
-  //
-  // Allocate the Fat Cache buffer
-  //
-  CacheBuffer = AllocateZeroPool (FatCacheSize + DataCacheSize);
-  if (CacheBuffer == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
 
   Volume->CacheBuffer            = CacheBuffer;
   DiskCache[CacheFat].CacheBase  = CacheBuffer;
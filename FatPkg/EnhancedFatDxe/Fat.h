@@ -84,6 +84,23 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define FAT_FATCACHE_GROUP_MIN_COUNT      1
 #define FAT_FATCACHE_GROUP_MAX_COUNT      16
 
+//
+// Number of data cache pages read in one disk request once sequential
+// access to the data cache is detected
+//
+#define FAT_DATACACHE_PREFETCH_PAGES  8
+
+//
+// Number of allocated clusters FatAllocateCluster skips in the FAT before
+// it builds the free cluster bitmap of the volume
+//
+#define FAT_FREE_CLUSTER_SCAN_LIMIT  0x1000
+
+//
+// Number of runs the extent map of an open file grows by
+//
+#define FAT_EXTENT_MAP_GROW_COUNT  16
+
 // For cache block bits, use a UINT64
 typedef UINT64 DIRTY_BLOCKS;
 #define BITS_PER_BYTE         8
@@ -152,6 +169,15 @@ typedef enum {
 #define RAW_ACCESS(a)     ((IO_MODE)((a) & 0x1))
 #define CACHE_TYPE(a)     ((CACHE_DATA_TYPE)((a) >> 2))
 
+//
+// A run of contiguous clusters in the cluster chain of a file
+//
+typedef struct {
+  UINTN    FileCluster;     // Index of the first cluster of the run within the file
+  UINTN    Cluster;         // First cluster of the run on the volume
+  UINTN    ClusterCount;
+} FAT_EXTENT;
+
 //
 // Disk cache tag
 //
@@ -170,14 +196,17 @@ typedef struct {
   BOOLEAN      Dirty;
   UINT8        PageAlignment;
   UINTN        GroupMask;
+  UINTN        NextPageNo;     // Page expected next if access is sequential
   CACHE_TAG    CacheTag[FAT_DATACACHE_GROUP_COUNT];
 } DISK_CACHE;
 
 //
-// Hash table size
+// Hash table size. The hash tables of a directory start with HASH_TABLE_SIZE
+// buckets and are doubled, up to HASH_TABLE_MAX_SIZE buckets, whenever the
+// directory holds more entries than buckets.
 //
-#define HASH_TABLE_SIZE  0x400
-#define HASH_TABLE_MASK  (HASH_TABLE_SIZE - 1)
+#define HASH_TABLE_SIZE      0x400
+#define HASH_TABLE_MAX_SIZE  0x10000
 
 //
 // The directory entry for opened directory
@@ -210,8 +239,10 @@ struct _FAT_ODIR {
   BOOLEAN       EndOfDir;                     // Indicate whether we have reached the end of the directory
   LIST_ENTRY    DirCacheLink;                 // Linked in Volume->DirCacheList when discarded
   UINTN         DirCacheTag;                  // The identification of the directory when in directory cache
-  FAT_DIRENT    *LongNameHashTable[HASH_TABLE_SIZE];
-  FAT_DIRENT    *ShortNameHashTable[HASH_TABLE_SIZE];
+  UINTN         HashTableMask;                // Number of hash table buckets minus one
+  UINTN         HashEntryCount;               // Number of directory entries in the hash tables
+  FAT_DIRENT    **LongNameHashTable;
+  FAT_DIRENT    **ShortNameHashTable;
 };
 
 typedef struct {
@@ -286,6 +317,13 @@ struct _FAT_OFILE {
   UINT64        PosDisk;        // on the disk
   UINTN         PosRem;         // remaining in this disk run
   //
+  // The cluster chain from its start, as runs of contiguous clusters.
+  // It is filled in as positions further in the file are accessed.
+  //
+  FAT_EXTENT    *Extents;
+  UINTN         ExtentCount;
+  UINTN         ExtentMaxCount;
+  //
   // The opened parent, full path length and currently opened child files
   //
   FAT_OFILE     *Parent;
@@ -349,6 +387,7 @@ struct _FAT_VOLUME {
   FAT_INFO_SECTOR                    FatInfoSector;  // Free cluster info
   UINTN                              FreeInfoPos;    // Pos with the free cluster info
   BOOLEAN                            FreeInfoValid;  // If free cluster info is valid
+  UINT64                             *FreeClusterBitmap; // A set bit for each free cluster, if built
   //
   // Unpacked Fat BPB info
   //
@@ -1815,6 +1854,25 @@ FatShortNameHashSearch (
   IN CHAR8     *ShortNameString
   );
 
+/**
+
+  Allocate the hash tables of the directory with HashTableSize buckets each.
+  The previous hash tables, if any, are freed and all the directory entries
+  in the directory entry list are hashed again.
+
+  @param  ODir                  - The directory.
+  @param  HashTableSize         - The number of buckets, a power of 2.
+
+  @retval EFI_SUCCESS           - The hash tables are allocated.
+  @retval EFI_OUT_OF_RESOURCES  - Not enough memory; the previous hash tables are kept.
+
+**/
+EFI_STATUS
+FatAllocateHashTable (
+  IN FAT_ODIR  *ODir,
+  IN UINTN     HashTableSize
+  );
+
 /**
 
   Insert directory entry to hash table.
@@ -161,10 +161,18 @@ FatSetFatEntry (
     if (Index < Volume->FatInfoSector.FreeInfo.NextCluster) {
       Volume->FatInfoSector.FreeInfo.NextCluster = (UINT32)Index;
     }
+
+    if (Volume->FreeClusterBitmap != NULL) {
+      Volume->FreeClusterBitmap[Index >> 6] |= LShiftU64 (1, Index & 0x3F);
+    }
   } else if ((Value != FAT_CLUSTER_FREE) && (OriginalVal == FAT_CLUSTER_FREE)) {
     if (Volume->FatInfoSector.FreeInfo.ClusterCount != 0) {
       Volume->FatInfoSector.FreeInfo.ClusterCount -= 1;
     }
+
+    if (Volume->FreeClusterBitmap != NULL) {
+      Volume->FreeClusterBitmap[Index >> 6] &= ~LShiftU64 (1, Index & 0x3F);
+    }
   }
 
   //
@@ -259,6 +267,131 @@ FatFreeClusters (
   return EFI_SUCCESS;
 }
 
+/**
+
+  Search the free cluster bitmap for the first run of at least ClusterCount
+  free clusters, starting at cluster Start.
+
+  Words of the bitmap with all clusters allocated or all clusters free are
+  passed over as a whole.
+
+  @param  Volume                - FAT file system volume with a free cluster bitmap.
+  @param  Start                 - The cluster to start the search at.
+  @param  ClusterCount          - The length of the run.
+
+  @return The first cluster of the run, or a value above Volume->MaxCluster + 1
+          if there is no such run.
+
+**/
+STATIC
+UINTN
+FatFindFreeClusterRun (
+  IN FAT_VOLUME  *Volume,
+  IN UINTN       Start,
+  IN UINTN       ClusterCount
+  )
+{
+  UINT64  *Bitmap;
+  UINTN   Index;
+  UINTN   RunStart;
+  UINTN   RunLength;
+
+  Bitmap    = Volume->FreeClusterBitmap;
+  RunStart  = 0;
+  RunLength = 0;
+  for (Index = MAX (Start, FAT_MIN_CLUSTER); Index <= Volume->MaxCluster + 1; ) {
+    if (((Index & 0x3F) == 0) && (Bitmap[Index >> 6] == 0)) {
+      RunLength = 0;
+      Index    += 64;
+      continue;
+    }
+
+    if (((Index & 0x3F) == 0) && (Bitmap[Index >> 6] == MAX_UINT64)) {
+      if (RunLength == 0) {
+        RunStart = Index;
+      }
+
+      RunLength += 64;
+      Index     += 64;
+    } else if ((Bitmap[Index >> 6] & LShiftU64 (1, Index & 0x3F)) != 0) {
+      if (RunLength == 0) {
+        RunStart = Index;
+      }
+
+      RunLength++;
+      Index++;
+    } else {
+      RunLength = 0;
+      Index++;
+      continue;
+    }
+
+    if (RunLength >= ClusterCount) {
+      return RunStart;
+    }
+  }
+
+  return MAX_UINTN;
+}
+
+/**
+
+  Allocate the free cluster bitmap of the volume. It is filled in by the
+  next FatComputeFreeInfo that scans the FAT.
+
+  @param  Volume                - FAT file system volume.
+
+  @retval TRUE                  - The bitmap is allocated.
+  @retval FALSE                 - Not enough memory for the bitmap.
+
+**/
+STATIC
+BOOLEAN
+FatAllocateFreeClusterBitmap (
+  IN FAT_VOLUME  *Volume
+  )
+{
+  if (Volume->FreeClusterBitmap == NULL) {
+    Volume->FreeClusterBitmap = AllocateZeroPool (((Volume->MaxCluster + 2 + 63) >> 6) * sizeof (UINT64));
+  }
+
+  return (BOOLEAN)(Volume->FreeClusterBitmap != NULL);
+}
+
+/**
+
+  Before allocating ClusterCount clusters one by one, move the position that
+  FatAllocateCluster searches from to a run of that many free clusters, so
+  that they are allocated contiguously. Nothing is done if the volume has no
+  free cluster bitmap or no such run.
+
+  @param  Volume                - FAT file system volume.
+  @param  ClusterCount          - The number of clusters to be allocated.
+
+**/
+STATIC
+VOID
+FatPrepareClusterRun (
+  IN FAT_VOLUME  *Volume,
+  IN UINTN       ClusterCount
+  )
+{
+  UINTN  Cluster;
+
+  if ((Volume->FreeClusterBitmap == NULL) || (ClusterCount < 2)) {
+    return;
+  }
+
+  Cluster = FatFindFreeClusterRun (Volume, Volume->FatInfoSector.FreeInfo.NextCluster, ClusterCount);
+  if (Cluster > Volume->MaxCluster + 1) {
+    Cluster = FatFindFreeClusterRun (Volume, FAT_MIN_CLUSTER, ClusterCount);
+  }
+
+  if (Cluster <= Volume->MaxCluster + 1) {
+    Volume->FatInfoSector.FreeInfo.NextCluster = (UINT32)Cluster;
+  }
+}
+
 /**
 
   Allocate a free cluster and return the cluster index.
@@ -275,6 +408,7 @@ FatAllocateCluster (
   )
 {
   UINTN  Cluster;
+  UINTN  Skipped;
 
   //
   // Start looking at FatFreePos for the next unallocated cluster
@@ -283,7 +417,25 @@ FatAllocateCluster (
     return (UINTN)FAT_CLUSTER_LAST;
   }
 
+  Skipped = 0;
   for ( ; ;) {
+    if (Volume->FreeClusterBitmap != NULL) {
+      //
+      // Search the bitmap from FatFreePos, then wrap around
+      //
+      Cluster = FatFindFreeClusterRun (Volume, Volume->FatInfoSector.FreeInfo.NextCluster, 1);
+      if (Cluster > Volume->MaxCluster + 1) {
+        Cluster = FatFindFreeClusterRun (Volume, FAT_MIN_CLUSTER, 1);
+        if (Cluster > Volume->MaxCluster + 1) {
+          Volume->FatInfoSector.FreeInfo.NextCluster = (UINT32)(Volume->MaxCluster + 2);
+          return (UINTN)FAT_CLUSTER_LAST;
+        }
+      }
+
+      Volume->FatInfoSector.FreeInfo.NextCluster = (UINT32)Cluster;
+      break;
+    }
+
     //
     // If the end of the list, return no available cluster
     //
@@ -307,6 +459,15 @@ FatAllocateCluster (
     // Try the next cluster
     //
     Volume->FatInfoSector.FreeInfo.NextCluster += 1;
+
+    //
+    // Skipping a long stretch of allocated clusters suggests a full or
+    // fragmented volume, so switch to searching a free cluster bitmap
+    //
+    if ((++Skipped == FAT_FREE_CLUSTER_SCAN_LIMIT) && FatAllocateFreeClusterBitmap (Volume)) {
+      Volume->FreeInfoValid = FALSE;
+      FatComputeFreeInfo (Volume);
+    }
   }
 
   Cluster                                     = Volume->FatInfoSector.FreeInfo.NextCluster;
@@ -361,6 +522,7 @@ FatShrinkEof (
   UINTN       CurSize;
   UINTN       Cluster;
   UINTN       LastCluster;
+  FAT_EXTENT  *Extent;
 
   Volume = OFile->Volume;
   ASSERT_VOLUME_LOCKED (Volume);
@@ -399,6 +561,19 @@ FatShrinkEof (
     OFile->FileCluster = FAT_CLUSTER_FREE;
   }
 
+  //
+  // Drop the runs of the freed clusters
+  //
+  while (OFile->ExtentCount > 0) {
+    Extent = &OFile->Extents[OFile->ExtentCount - 1];
+    if (Extent->FileCluster < NewSize) {
+      Extent->ClusterCount = MIN (Extent->ClusterCount, NewSize - Extent->FileCluster);
+      break;
+    }
+
+    OFile->ExtentCount--;
+  }
+
   //
   // Set CurrentCluster == FileCluster
   // to force a recalculation of Position related stuffs
@@ -492,6 +667,7 @@ FatGrowEof (
     // Loop until we've allocated enough space
     //
     LastCluster = OFile->FileLastCluster;
+    FatPrepareClusterRun (Volume, NewSize - CurSize);
 
     while (CurSize < NewSize) {
       NewCluster = FatAllocateCluster (Volume);
@@ -545,6 +721,150 @@ Done:
   return Status;
 }
 
+/**
+
+  Add the next cluster of the file's cluster chain to the extent map of the
+  open file, either by extending the last run or by starting a new one.
+
+  @param  OFile                 - The open file.
+
+  @retval EFI_SUCCESS           - The cluster is added to the extent map.
+  @retval EFI_END_OF_FILE       - The extent map already covers the whole cluster chain.
+  @retval EFI_VOLUME_CORRUPTED  - Cluster chain corrupt.
+  @retval EFI_OUT_OF_RESOURCES  - Can not allocate memory for the extent map.
+
+**/
+STATIC
+EFI_STATUS
+FatGrowExtentMap (
+  IN FAT_OFILE  *OFile
+  )
+{
+  FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
+  FAT_EXTENT  *NewExtents;
+  UINTN       FileCluster;
+  UINTN       Cluster;
+
+  Volume = OFile->Volume;
+  Extent = NULL;
+  if (OFile->ExtentCount == 0) {
+    FileCluster = 0;
+    Cluster     = OFile->FileCluster;
+  } else {
+    Extent      = &OFile->Extents[OFile->ExtentCount - 1];
+    FileCluster = Extent->FileCluster + Extent->ClusterCount;
+    Cluster     = FatGetFatEntry (Volume, Extent->Cluster + Extent->ClusterCount - 1);
+  }
+
+  if ((Cluster < FAT_MIN_CLUSTER) || (Cluster > Volume->MaxCluster + 1)) {
+    if ((Extent != NULL) && FAT_END_OF_FAT_CHAIN (Cluster)) {
+      return EFI_END_OF_FILE;
+    }
+
+    DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatGrowExtentMap: cluster chain corrupt\n"));
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  if ((Extent != NULL) && (Cluster == Extent->Cluster + Extent->ClusterCount)) {
+    Extent->ClusterCount++;
+    return EFI_SUCCESS;
+  }
+
+  if (OFile->ExtentCount == OFile->ExtentMaxCount) {
+    NewExtents = ReallocatePool (
+                   OFile->ExtentMaxCount * sizeof (FAT_EXTENT),
+                   (OFile->ExtentMaxCount + FAT_EXTENT_MAP_GROW_COUNT) * sizeof (FAT_EXTENT),
+                   OFile->Extents
+                   );
+    if (NewExtents == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    OFile->Extents         = NewExtents;
+    OFile->ExtentMaxCount += FAT_EXTENT_MAP_GROW_COUNT;
+  }
+
+  Extent               = &OFile->Extents[OFile->ExtentCount];
+  Extent->FileCluster  = FileCluster;
+  Extent->Cluster      = Cluster;
+  Extent->ClusterCount = 1;
+  OFile->ExtentCount++;
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Find the run of the extent map that holds the cluster at index ClusterIndex
+  of the file, filling in the extent map up to it as needed.
+
+  @param  OFile                 - The open file.
+  @param  ClusterIndex          - Index of the cluster within the file.
+  @param  ExtentIndex           - Index of the run in the extent map.
+
+  @retval EFI_SUCCESS           - The run is found.
+  @retval EFI_VOLUME_CORRUPTED  - Cluster chain corrupt.
+  @retval EFI_OUT_OF_RESOURCES  - Can not allocate memory for the extent map.
+
+**/
+STATIC
+EFI_STATUS
+FatLookupExtent (
+  IN  FAT_OFILE  *OFile,
+  IN  UINTN      ClusterIndex,
+  OUT UINTN      *ExtentIndex
+  )
+{
+  EFI_STATUS  Status;
+  FAT_EXTENT  *Extent;
+  UINTN       Low;
+  UINTN       High;
+  UINTN       Middle;
+
+  //
+  // The whole cluster chain is replaced when the file's first cluster changes
+  //
+  if ((OFile->ExtentCount > 0) && (OFile->Extents[0].Cluster != OFile->FileCluster)) {
+    OFile->ExtentCount = 0;
+  }
+
+  while (TRUE) {
+    if (OFile->ExtentCount > 0) {
+      Extent = &OFile->Extents[OFile->ExtentCount - 1];
+      if (ClusterIndex < Extent->FileCluster + Extent->ClusterCount) {
+        break;
+      }
+    }
+
+    Status = FatGrowExtentMap (OFile);
+    if (Status == EFI_END_OF_FILE) {
+      DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatLookupExtent: cluster chain too short\n"));
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  //
+  // Binary search for the last run starting at or before ClusterIndex
+  //
+  Low  = 0;
+  High = OFile->ExtentCount - 1;
+  while (Low < High) {
+    Middle = (Low + High + 1) / 2;
+    if (OFile->Extents[Middle].FileCluster <= ClusterIndex) {
+      Low = Middle;
+    } else {
+      High = Middle - 1;
+    }
+  }
+
+  *ExtentIndex = Low;
+  return EFI_SUCCESS;
+}
+
 /**
 
   Seek OFile to requested position, and calculate the number of
@@ -565,8 +885,12 @@ FatOFilePosition (
   IN UINTN      PosLimit
   )
 {
+  EFI_STATUS  Status;
   FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
   UINTN       ClusterSize;
+  UINTN       ClusterIndex;
+  UINTN       ExtentIndex;
   UINTN       Cluster;
   UINTN       StartPos;
   UINTN       Run;
@@ -585,37 +909,18 @@ FatOFilePosition (
     Run            = OFile->FileSize - Position;
   } else {
     //
-    // Run the file's cluster chain to find the current position
-    // If possible, run from the current cluster rather than
-    // start from beginning
-    // Assumption: OFile->Position is always consistent with
-    // OFile->FileCurrentCluster.
-    // OFile->Position is not modified outside this function;
-    // OFile->FileCurrentCluster is modified outside this function
-    // to be the same as OFile->FileCluster
-    // when OFile->FileCluster is updated, so make a check of this
-    // and invalidate the original OFile->Position in this case
+    // Look up the cluster of the position in the file's extent map,
+    // which records the cluster chain as runs of contiguous clusters
     //
-    Cluster  = OFile->FileCurrentCluster;
-    StartPos = OFile->Position;
-    if ((Position < StartPos) || (OFile->FileCluster == Cluster)) {
-      StartPos = 0;
-      Cluster  = OFile->FileCluster;
+    ClusterIndex = Position >> Volume->ClusterAlignment;
+    Status       = FatLookupExtent (OFile, ClusterIndex, &ExtentIndex);
+    if (EFI_ERROR (Status)) {
+      return Status;
     }
 
-    while (StartPos + ClusterSize <= Position) {
-      StartPos += ClusterSize;
-      if ((Cluster == FAT_CLUSTER_FREE) || (Cluster >= FAT_CLUSTER_SPECIAL)) {
-        DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatOFilePosition:" " cluster chain corrupt\n"));
-        return EFI_VOLUME_CORRUPTED;
-      }
-
-      Cluster = FatGetFatEntry (Volume, Cluster);
-    }
-
-    if ((Cluster < FAT_MIN_CLUSTER) || (Cluster > Volume->MaxCluster + 1)) {
-      return EFI_VOLUME_CORRUPTED;
-    }
+    Extent   = &OFile->Extents[ExtentIndex];
+    Cluster  = Extent->Cluster + ClusterIndex - Extent->FileCluster;
+    StartPos = ClusterIndex << Volume->ClusterAlignment;
 
     OFile->PosDisk = Volume->FirstClusterPos +
                      LShiftU64 (Cluster - FAT_MIN_CLUSTER, Volume->ClusterAlignment) +
@@ -624,14 +929,20 @@ FatOFilePosition (
     OFile->Position           = StartPos;
 
     //
-    // Compute the number of consecutive clusters in the file
+    // Compute the number of consecutive clusters in the file. If the run
+    // is the last one known, fill in more of it as far as PosLimit needs.
     //
-    Run = StartPos + ClusterSize - Position;
-    if (!FAT_END_OF_FAT_CHAIN (Cluster)) {
-      while ((FatGetFatEntry (Volume, Cluster) == Cluster + 1) && Run < PosLimit) {
-        Run     += ClusterSize;
-        Cluster += 1;
+    Run = ((Extent->FileCluster + Extent->ClusterCount) << Volume->ClusterAlignment) - Position;
+    while ((ExtentIndex == OFile->ExtentCount - 1) && (Run < PosLimit)) {
+      if (EFI_ERROR (FatGrowExtentMap (OFile))) {
+        break;
       }
+
+      if (ExtentIndex != OFile->ExtentCount - 1) {
+        break;
+      }
+
+      Run += ClusterSize;
     }
   }
 
@@ -724,11 +1035,17 @@ FatComputeFreeInfo (
   UINTN  Index;
 
   //
-  // If we don't have valid info, compute it now
+  // If we don't have valid info, compute it now. The free cluster bitmap
+  // is filled in by the same scan, allocating it if memory allows, so that
+  // later allocations do not need to scan the FAT.
   //
   if (!Volume->FreeInfoValid) {
     Volume->FreeInfoValid                       = TRUE;
     Volume->FatInfoSector.FreeInfo.ClusterCount = 0;
+    if (FatAllocateFreeClusterBitmap (Volume)) {
+      ZeroMem (Volume->FreeClusterBitmap, ((Volume->MaxCluster + 2 + 63) >> 6) * sizeof (UINT64));
+    }
+
     for (Index = Volume->MaxCluster + 1; Index >= FAT_MIN_CLUSTER; Index--) {
       if (Volume->DiskError) {
         break;
@@ -737,9 +1054,20 @@ FatComputeFreeInfo (
       if (FatGetFatEntry (Volume, Index) == FAT_CLUSTER_FREE) {
         Volume->FatInfoSector.FreeInfo.ClusterCount += 1;
         Volume->FatInfoSector.FreeInfo.NextCluster   = (UINT32)Index;
+        if (Volume->FreeClusterBitmap != NULL) {
+          Volume->FreeClusterBitmap[Index >> 6] |= LShiftU64 (1, Index & 0x3F);
+        }
       }
     }
 
+    //
+    // A bitmap from an incomplete scan cannot be trusted
+    //
+    if (Volume->DiskError && (Volume->FreeClusterBitmap != NULL)) {
+      FreePool (Volume->FreeClusterBitmap);
+      Volume->FreeClusterBitmap = NULL;
+    }
+
     Volume->FatInfoSector.Signature          = FAT_INFO_SIGNATURE;
     Volume->FatInfoSector.InfoBeginSignature = FAT_INFO_BEGIN_SIGNATURE;
     Volume->FatInfoSector.InfoEndSignature   = FAT_INFO_END_SIGNATURE;
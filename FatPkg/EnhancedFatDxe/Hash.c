@@ -14,7 +14,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
   @param  LongNameString        - The long name string to be hashed.
 
-  @return HashValue.
+  @return HashValue, to be masked with the hash table mask of the directory.
 
 **/
 STATIC
@@ -34,7 +34,7 @@ FatHashLongName (
     );
   FatStrUpr (UpCasedLongFileName);
   gBS->CalculateCrc32 (UpCasedLongFileName, StrSize (UpCasedLongFileName), &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
 }
 
 /**
@@ -43,7 +43,7 @@ FatHashLongName (
 
   @param  ShortNameString       - The short name string to be hashed.
 
-  @return HashValue
+  @return HashValue, to be masked with the hash table mask of the directory.
 
 **/
 STATIC
@@ -55,7 +55,7 @@ FatHashShortName (
   UINT32  HashValue;
 
   gBS->CalculateCrc32 (ShortNameString, FAT_NAME_LEN, &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
 }
 
 /**
@@ -76,7 +76,7 @@ FatLongNameHashSearch (
 {
   FAT_DIRENT  **PreviousHashNode;
 
-  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString)];
+  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString) & ODir->HashTableMask];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->LongNameForwardLink
        )
@@ -107,7 +107,7 @@ FatShortNameHashSearch (
 {
   FAT_DIRENT  **PreviousHashNode;
 
-  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString)];
+  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString) & ODir->HashTableMask];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->ShortNameForwardLink
        )
@@ -122,37 +122,112 @@ FatShortNameHashSearch (
 
 /**
 
-  Insert directory entry to hash table.
+  Link directory entry into the hash tables of the directory.
 
   @param  ODir                  - The parent directory.
   @param  DirEnt                - The directory entry node.
 
 **/
+STATIC
 VOID
-FatInsertToHashTable (
+FatLinkToHashTable (
   IN FAT_ODIR    *ODir,
   IN FAT_DIRENT  *DirEnt
   )
 {
   FAT_DIRENT  **HashTable;
-  UINT32      HashTableIndex;
+  UINTN       HashTableIndex;
 
   //
   // Insert hash table index for short name
   //
-  HashTableIndex               = FatHashShortName (DirEnt->Entry.FileName);
+  HashTableIndex               = FatHashShortName (DirEnt->Entry.FileName) & ODir->HashTableMask;
   HashTable                    = ODir->ShortNameHashTable;
   DirEnt->ShortNameForwardLink = HashTable[HashTableIndex];
   HashTable[HashTableIndex]    = DirEnt;
   //
   // Insert hash table index for long name
   //
-  HashTableIndex              = FatHashLongName (DirEnt->FileString);
+  HashTableIndex              = FatHashLongName (DirEnt->FileString) & ODir->HashTableMask;
   HashTable                   = ODir->LongNameHashTable;
   DirEnt->LongNameForwardLink = HashTable[HashTableIndex];
   HashTable[HashTableIndex]   = DirEnt;
 }
 
+/**
+
+  Allocate the hash tables of the directory with HashTableSize buckets each.
+  The previous hash tables, if any, are freed and all the directory entries
+  in the directory entry list are hashed again.
+
+  @param  ODir                  - The directory.
+  @param  HashTableSize         - The number of buckets, a power of 2.
+
+  @retval EFI_SUCCESS           - The hash tables are allocated.
+  @retval EFI_OUT_OF_RESOURCES  - Not enough memory; the previous hash tables are kept.
+
+**/
+EFI_STATUS
+FatAllocateHashTable (
+  IN FAT_ODIR  *ODir,
+  IN UINTN     HashTableSize
+  )
+{
+  FAT_DIRENT  **HashTable;
+  LIST_ENTRY  *Link;
+
+  HashTable = AllocateZeroPool (2 * HashTableSize * sizeof (FAT_DIRENT *));
+  if (HashTable == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  if (ODir->LongNameHashTable != NULL) {
+    FreePool (ODir->LongNameHashTable);
+  }
+
+  ODir->LongNameHashTable  = HashTable;
+  ODir->ShortNameHashTable = HashTable + HashTableSize;
+  ODir->HashTableMask      = HashTableSize - 1;
+
+  for (Link = ODir->ChildList.ForwardLink; Link != &ODir->ChildList; Link = Link->ForwardLink) {
+    FatLinkToHashTable (ODir, DIRENT_FROM_LINK (Link));
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Insert directory entry to hash table. The directory entry must already be
+  in the directory entry list of the directory.
+
+  The hash tables are doubled when the directory holds more entries than
+  buckets, so that lookups in huge directories stay short.
+
+  @param  ODir                  - The parent directory.
+  @param  DirEnt                - The directory entry node.
+
+**/
+VOID
+FatInsertToHashTable (
+  IN FAT_ODIR    *ODir,
+  IN FAT_DIRENT  *DirEnt
+  )
+{
+  ODir->HashEntryCount++;
+  if ((ODir->HashEntryCount > ODir->HashTableMask + 1) &&
+      (ODir->HashTableMask + 1 < HASH_TABLE_MAX_SIZE) &&
+      !EFI_ERROR (FatAllocateHashTable (ODir, (ODir->HashTableMask + 1) * 2)))
+  {
+    //
+    // DirEnt is hashed along with the rest of the directory entry list
+    //
+    return;
+  }
+
+  FatLinkToHashTable (ODir, DirEnt);
+}
+
 /**
 
   Delete directory entry from hash table.
@@ -169,4 +244,5 @@ FatDeleteFromHashTable (
 {
   *FatShortNameHashSearch (ODir, DirEnt->Entry.FileName) = DirEnt->ShortNameForwardLink;
   *FatLongNameHashSearch (ODir, DirEnt->FileString)      = DirEnt->LongNameForwardLink;
+  ODir->HashEntryCount--;
 }
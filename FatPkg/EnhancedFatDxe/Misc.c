@@ -468,6 +468,10 @@ FatFreeVolume (
     FreePool (Volume->CacheBuffer);
   }
 
+  if (Volume->FreeClusterBitmap != NULL) {
+    FreePool (Volume->FreeClusterBitmap);
+  }
+
   //
   // Free directory cache
   //
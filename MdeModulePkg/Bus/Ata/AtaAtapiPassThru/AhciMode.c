@@ -1519,6 +1519,355 @@ AhciNonDataTransfer (
   return Status;
 }
 
+/**
+  Build the command list entry and command table of one queued command.
+
+  @param[in]  AhciRegisters     The pointer to the EFI_AHCI_REGISTERS.
+  @param[in]  PortMultiplier    The port multiplier port number.
+  @param[in]  Read              The transfer direction.
+  @param[in]  Tag               The command slot and NCQ tag of the command.
+  @param[in]  Lba               The starting LBA of the command.
+  @param[in]  SectorCount       The number of sectors to transfer.
+  @param[in]  DataPhysicalAddr  The bus master address of the data.
+  @param[in]  DataLength        The number of bytes to transfer.
+
+**/
+STATIC
+VOID
+AhciBuildNcqCommand (
+  IN EFI_AHCI_REGISTERS    *AhciRegisters,
+  IN UINT8                 PortMultiplier,
+  IN BOOLEAN               Read,
+  IN UINT8                 Tag,
+  IN UINT64                Lba,
+  IN UINT32                SectorCount,
+  IN EFI_PHYSICAL_ADDRESS  DataPhysicalAddr,
+  IN UINT32                DataLength
+  )
+{
+  EFI_AHCI_NCQ_COMMAND_TABLE  *CommandTable;
+  EFI_AHCI_COMMAND_FIS        *CFis;
+  EFI_AHCI_COMMAND_LIST       *CmdList;
+  UINT32                      PrdtIndex;
+  UINT32                      RemainedData;
+  DATA_64                     Data64;
+
+  CommandTable = &AhciRegisters->AhciNcqCommandTable[Tag];
+  ZeroMem (CommandTable, sizeof (EFI_AHCI_NCQ_COMMAND_TABLE));
+
+  //
+  // READ/WRITE FPDMA QUEUED carries the sector count in the feature registers
+  // and the tag in bits 7:3 of the sector count register.
+  //
+  CFis                     = &CommandTable->CommandFis;
+  CFis->AhciCFisType       = EFI_AHCI_FIS_REGISTER_H2D;
+  CFis->AhciCFisCmdInd     = 0x1;
+  CFis->AhciCFisPmNum      = PortMultiplier;
+  CFis->AhciCFisCmd        = Read ? ATA_CMD_READ_FPDMA_QUEUED : ATA_CMD_WRITE_FPDMA_QUEUED;
+  CFis->AhciCFisFeature    = (UINT8)SectorCount;
+  CFis->AhciCFisFeatureExp = (UINT8)(SectorCount >> 8);
+  CFis->AhciCFisSecCount   = (UINT8)(Tag << 3);
+  CFis->AhciCFisSecNum     = (UINT8)Lba;
+  CFis->AhciCFisClyLow     = (UINT8)RShiftU64 (Lba, 8);
+  CFis->AhciCFisClyHigh    = (UINT8)RShiftU64 (Lba, 16);
+  CFis->AhciCFisSecNumExp  = (UINT8)RShiftU64 (Lba, 24);
+  CFis->AhciCFisClyLowExp  = (UINT8)RShiftU64 (Lba, 32);
+  CFis->AhciCFisClyHighExp = (UINT8)RShiftU64 (Lba, 40);
+  CFis->AhciCFisDevHead    = ATA_FPDMA_DEVICE_LBA;
+
+  RemainedData = DataLength;
+  PrdtIndex    = 0;
+  while (RemainedData > 0) {
+    ASSERT (PrdtIndex < AHCI_NCQ_PRDT_NUMBER);
+    Data64.Uint64                                   = DataPhysicalAddr;
+    CommandTable->PrdtTable[PrdtIndex].AhciPrdtDba  = Data64.Uint32.Lower32;
+    CommandTable->PrdtTable[PrdtIndex].AhciPrdtDbau = Data64.Uint32.Upper32;
+    if (RemainedData <= EFI_AHCI_MAX_DATA_PER_PRDT) {
+      CommandTable->PrdtTable[PrdtIndex].AhciPrdtDbc = RemainedData - 1;
+      CommandTable->PrdtTable[PrdtIndex].AhciPrdtIoc = 1;
+      RemainedData                                   = 0;
+    } else {
+      CommandTable->PrdtTable[PrdtIndex].AhciPrdtDbc = EFI_AHCI_MAX_DATA_PER_PRDT - 1;
+      RemainedData                                  -= EFI_AHCI_MAX_DATA_PER_PRDT;
+      DataPhysicalAddr                              += EFI_AHCI_MAX_DATA_PER_PRDT;
+    }
+
+    PrdtIndex++;
+  }
+
+  CmdList = &AhciRegisters->AhciCmdList[Tag];
+  ZeroMem (CmdList, sizeof (EFI_AHCI_COMMAND_LIST));
+  CmdList->AhciCmdCfl   = EFI_AHCI_FIS_REGISTER_H2D_LENGTH / 4;
+  CmdList->AhciCmdW     = Read ? 0 : 1;
+  CmdList->AhciCmdPmp   = PortMultiplier;
+  CmdList->AhciCmdPrdtl = PrdtIndex;
+
+  Data64.Uint64         = (UINT64)(UINTN)&AhciRegisters->AhciNcqCommandTablePciAddr[Tag];
+  CmdList->AhciCmdCtba  = Data64.Uint32.Lower32;
+  CmdList->AhciCmdCtbau = Data64.Uint32.Upper32;
+}
+
+/**
+  Execute a blocking READ/WRITE DMA EXT as a set of native command queuing
+  commands.
+
+  The transfer is split across the command slots the HBA and the device both
+  support, and every slot is refilled as soon as the device completes it, so
+  the device always has a full queue to reorder and overlap. Anything this
+  function can not queue is reported as EFI_UNSUPPORTED and the caller is
+  expected to fall back to AhciDmaTransfer(); the same is done after a queued
+  command fails so that the non-queued path can retry it and report the
+  error status.
+
+  @param[in]       Instance            The ATA_ATAPI_PASS_THRU_INSTANCE protocol instance.
+  @param[in]       AhciRegisters       The pointer to the EFI_AHCI_REGISTERS.
+  @param[in]       Port                The number of port.
+  @param[in]       PortMultiplier      The port multiplier port number.
+  @param[in]       Read                The transfer direction.
+  @param[in]       AtaCommandBlock     The EFI_ATA_COMMAND_BLOCK data.
+  @param[in, out]  AtaStatusBlock      The EFI_ATA_STATUS_BLOCK data.
+  @param[in, out]  MemoryAddr          The pointer to the data buffer.
+  @param[in]       DataCount           The data count to be transferred.
+  @param[in]       Timeout             The timeout value of non data transfer, uses 100ns as a unit.
+
+  @retval EFI_SUCCESS         The data was transferred with queued commands.
+  @retval EFI_UNSUPPORTED     The request can not be, or failed to be, executed
+                              with queued commands.
+  @retval EFI_BAD_BUFFER_SIZE The data buffer could not be mapped.
+
+**/
+EFI_STATUS
+EFIAPI
+AhciNcqTransfer (
+  IN     ATA_ATAPI_PASS_THRU_INSTANCE  *Instance,
+  IN     EFI_AHCI_REGISTERS            *AhciRegisters,
+  IN     UINT8                         Port,
+  IN     UINT8                         PortMultiplier,
+  IN     BOOLEAN                       Read,
+  IN     EFI_ATA_COMMAND_BLOCK         *AtaCommandBlock,
+  IN OUT EFI_ATA_STATUS_BLOCK          *AtaStatusBlock,
+  IN OUT VOID                          *MemoryAddr,
+  IN     UINT32                        DataCount,
+  IN     UINT64                        Timeout
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_PCI_IO_PROTOCOL            *PciIo;
+  LIST_ENTRY                     *Node;
+  EFI_ATA_DEVICE_INFO            *DeviceInfo;
+  ATA_IDENTIFY_DATA              *IdentifyData;
+  EFI_PCI_IO_PROTOCOL_OPERATION  Flag;
+  EFI_PHYSICAL_ADDRESS           PhyAddr;
+  VOID                           *Map;
+  UINTN                          MapLength;
+  EFI_TPL                        OldTpl;
+  UINT32                         Capability;
+  UINT32                         Depth;
+  UINT32                         SectorCount;
+  UINT32                         SectorSize;
+  UINT32                         ChunkSectors;
+  UINT32                         NextSector;
+  UINT32                         Count;
+  UINT32                         Issued;
+  UINT32                         Active;
+  UINT32                         PortInterrupt;
+  UINT32                         Offset;
+  UINT64                         Lba;
+  UINT64                         Delay;
+  UINT8                          Tag;
+
+  PciIo = Instance->PciIo;
+
+  if ((AhciRegisters->AhciNcqCommandTable == NULL) || (PortMultiplier != 0)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (AtaCommandBlock->AtaCommand != (Read ? ATA_CMD_READ_DMA_EXT : ATA_CMD_WRITE_DMA_EXT)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Capability = AhciReadReg (PciIo, EFI_AHCI_CAPABILITY_OFFSET);
+  if ((Capability & EFI_AHCI_CAP_SNCQ) == 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Only directly attached hard disks are enumerated in AHCI mode, and their
+  // IDENTIFY data tells whether the device supports queuing and how deep.
+  //
+  Node = SearchDeviceInfoList (Instance, Port, 0xFFFF, EfiIdeHarddisk);
+  if (Node == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  DeviceInfo   = ATA_ATAPI_DEVICE_INFO_FROM_THIS (Node);
+  IdentifyData = &DeviceInfo->IdentifyData->AtaData;
+  if ((IdentifyData->serial_ata_capabilities == 0xFFFF) ||
+      ((IdentifyData->serial_ata_capabilities & BIT8) == 0))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  Depth = MIN ((UINT32)(IdentifyData->queue_depth & 0x1F) + 1, ((Capability & 0x1F00) >> 8) + 1);
+  Depth = MIN (Depth, AHCI_NCQ_MAX_DEPTH);
+
+  SectorCount = AtaCommandBlock->AtaSectorCount | ((UINT32)AtaCommandBlock->AtaSectorCountExp << 8);
+  if (SectorCount == 0) {
+    SectorCount = 0x10000;
+  }
+
+  if ((DataCount == 0) || ((DataCount % SectorCount) != 0)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  SectorSize = DataCount / SectorCount;
+
+  //
+  // Spread the sectors over the queue, but keep every command large enough to
+  // be worth a slot and small enough for the per-slot PRD table.
+  //
+  ChunkSectors = (SectorCount + Depth - 1) / Depth;
+  ChunkSectors = MAX (ChunkSectors, AHCI_NCQ_MIN_TRANSFER_SIZE / SectorSize);
+  ChunkSectors = MIN (ChunkSectors, (AHCI_NCQ_PRDT_NUMBER * EFI_AHCI_MAX_DATA_PER_PRDT) / SectorSize);
+  if ((Depth < 2) || (ChunkSectors == 0) || (ChunkSectors >= SectorCount)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Lba = AtaCommandBlock->AtaSectorNumber |
+        ((UINT64)AtaCommandBlock->AtaCylinderLow << 8) |
+        ((UINT64)AtaCommandBlock->AtaCylinderHigh << 16) |
+        LShiftU64 (AtaCommandBlock->AtaSectorNumberExp, 24) |
+        LShiftU64 (AtaCommandBlock->AtaCylinderLowExp, 32) |
+        LShiftU64 (AtaCommandBlock->AtaCylinderHighExp, 40);
+
+  if (Read) {
+    Flag = EfiPciIoOperationBusMasterWrite;
+  } else {
+    Flag = EfiPciIoOperationBusMasterRead;
+  }
+
+  MapLength = DataCount;
+  Status    = PciIo->Map (
+                       PciIo,
+                       Flag,
+                       MemoryAddr,
+                       &MapLength,
+                       &PhyAddr,
+                       &Map
+                       );
+  if (EFI_ERROR (Status) || (DataCount != MapLength)) {
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  //
+  // Before starting the Blocking BlockIO operation, push to finish all non-blocking
+  // BlockIO tasks.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  while (!IsListEmpty (&Instance->NonBlockingTaskList)) {
+    AsyncNonBlockingTransferRoutine (NULL, Instance);
+    MicroSecondDelay (100);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  ZeroMem (
+    (VOID *)((UINTN)AhciRegisters->AhciRFis + sizeof (EFI_AHCI_RECEIVED_FIS) * Port),
+    sizeof (EFI_AHCI_RECEIVED_FIS)
+    );
+
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
+  AhciAndReg (PciIo, Offset, (UINT32) ~(EFI_AHCI_PORT_CMD_DLAE | EFI_AHCI_PORT_CMD_ATAPI));
+
+  //
+  // Start the port the same way as AhciStartCommand() does. The slots are
+  // issued below, each only after its PxSACT bit is set.
+  //
+  Status = AhciStartPort (PciIo, Port, Timeout);
+  if (EFI_ERROR (Status)) {
+    PciIo->Unmap (PciIo, Map);
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Keep every slot busy until all sectors have been issued, then wait for the
+  // outstanding commands to drain. PxSACT and PxCI are written with only the
+  // new slot bit set since writing zero to either register has no effect.
+  //
+  Issued     = 0;
+  NextSector = 0;
+  Delay      = DivU64x32 (Timeout, 1000) + 1;
+  Status     = EFI_SUCCESS;
+  while ((NextSector < SectorCount) || (Issued != 0)) {
+    for (Tag = 0; (Tag < Depth) && (NextSector < SectorCount); Tag++) {
+      if ((Issued & (UINT32)(1 << Tag)) != 0) {
+        continue;
+      }
+
+      Count = MIN (ChunkSectors, SectorCount - NextSector);
+      AhciBuildNcqCommand (
+        AhciRegisters,
+        PortMultiplier,
+        Read,
+        Tag,
+        Lba + NextSector,
+        Count,
+        PhyAddr + MultU64x32 (NextSector, SectorSize),
+        Count * SectorSize
+        );
+
+      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SACT;
+      AhciWriteReg (PciIo, Offset, (UINT32)(1 << Tag));
+      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CI;
+      AhciWriteReg (PciIo, Offset, (UINT32)(1 << Tag));
+
+      Issued     |= (UINT32)(1 << Tag);
+      NextSector += Count;
+    }
+
+    Offset        = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_IS;
+    PortInterrupt = AhciReadReg (PciIo, Offset);
+    if ((PortInterrupt & EFI_AHCI_PORT_IS_ERROR_MASK) != 0) {
+      Status = EFI_DEVICE_ERROR;
+      break;
+    }
+
+    Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SACT;
+    Active = AhciReadReg (PciIo, Offset);
+    if ((Issued & ~Active) != 0) {
+      Issued &= Active;
+      Delay   = DivU64x32 (Timeout, 1000) + 1;
+      continue;
+    }
+
+    if ((Timeout != 0) && (--Delay == 0)) {
+      Status = EFI_TIMEOUT;
+      break;
+    }
+
+    //
+    // Stall for 100 microseconds.
+    //
+    MicroSecondDelay (100);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "NCQ transfer on port %d failed: %r, falling back to DMA\n", Port, Status));
+    AhciRecoverPortError (PciIo, Port);
+  }
+
+  AhciStopCommand (PciIo, Port, Timeout);
+  AhciDisableFisReceive (PciIo, Port, Timeout);
+  PciIo->Unmap (PciIo, Map);
+
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  AhciDumpPortStatus (PciIo, AhciRegisters, Port, AtaStatusBlock);
+  return EFI_SUCCESS;
+}
+
 /**
   Stop command running for giving port
 
@@ -1563,28 +1912,26 @@ AhciStopCommand (
 }
 
 /**
-  Start command for give slot on specific port.
+  Start the command list processing of a specific port, without issuing any
+  command slot.
 
   @param  PciIo              The PCI IO protocol instance.
   @param  Port               The number of port.
-  @param  CommandSlot        The number of Command Slot.
   @param  Timeout            The timeout value of start, uses 100ns as a unit.
 
-  @retval EFI_DEVICE_ERROR   The command start unsuccessfully.
+  @retval EFI_DEVICE_ERROR   The port start unsuccessfully.
   @retval EFI_TIMEOUT        The operation is time out.
-  @retval EFI_SUCCESS        The command start successfully.
+  @retval EFI_SUCCESS        The port start successfully.
 
 **/
 EFI_STATUS
 EFIAPI
-AhciStartCommand (
+AhciStartPort (
   IN  EFI_PCI_IO_PROTOCOL  *PciIo,
   IN  UINT8                Port,
-  IN  UINT8                CommandSlot,
   IN  UINT64               Timeout
   )
 {
-  UINT32      CmdSlotBit;
   EFI_STATUS  Status;
   UINT32      PortStatus;
   UINT32      StartCmd;
@@ -1597,8 +1944,6 @@ AhciStartCommand (
   //
   Capability = AhciReadReg (PciIo, EFI_AHCI_CAPABILITY_OFFSET);
 
-  CmdSlotBit = (UINT32)(1 << CommandSlot);
-
   AhciClearPortStatus (
     PciIo,
     Port
@@ -1645,6 +1990,42 @@ AhciStartCommand (
   Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
   AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_ST | StartCmd);
 
+  return EFI_SUCCESS;
+}
+
+/**
+  Start command for give slot on specific port.
+
+  @param  PciIo              The PCI IO protocol instance.
+  @param  Port               The number of port.
+  @param  CommandSlot        The number of Command Slot.
+  @param  Timeout            The timeout value of start, uses 100ns as a unit.
+
+  @retval EFI_DEVICE_ERROR   The command start unsuccessfully.
+  @retval EFI_TIMEOUT        The operation is time out.
+  @retval EFI_SUCCESS        The command start successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+AhciStartCommand (
+  IN  EFI_PCI_IO_PROTOCOL  *PciIo,
+  IN  UINT8                Port,
+  IN  UINT8                CommandSlot,
+  IN  UINT64               Timeout
+  )
+{
+  UINT32      CmdSlotBit;
+  EFI_STATUS  Status;
+  UINT32      Offset;
+
+  CmdSlotBit = (UINT32)(1 << CommandSlot);
+
+  Status = AhciStartPort (PciIo, Port, Timeout);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   //
   // Setting the command
   //
@@ -2200,6 +2581,74 @@ AhciPacketCommandExecute (
   return Status;
 }
 
+/**
+  Allocate the per-slot command tables used by native command queuing.
+
+  The tables are optional; when they can not be allocated every command is
+  issued through the shared command table.
+
+  @param  PciIo                 The PCI IO protocol instance.
+  @param  AhciRegisters         The pointer to the EFI_AHCI_REGISTERS.
+  @param  Support64Bit          Whether the HBA supports 64-bit addressing.
+
+**/
+STATIC
+VOID
+AhciCreateNcqCommandTable (
+  IN     EFI_PCI_IO_PROTOCOL  *PciIo,
+  IN OUT EFI_AHCI_REGISTERS   *AhciRegisters,
+  IN     BOOLEAN              Support64Bit
+  )
+{
+  EFI_STATUS            Status;
+  UINTN                 Bytes;
+  VOID                  *Buffer;
+  EFI_PHYSICAL_ADDRESS  PciAddr;
+
+  Buffer = NULL;
+  Bytes  = AHCI_NCQ_MAX_DEPTH * sizeof (EFI_AHCI_NCQ_COMMAND_TABLE);
+  Status = PciIo->AllocateBuffer (
+                    PciIo,
+                    AllocateAnyPages,
+                    EfiBootServicesData,
+                    EFI_SIZE_TO_PAGES (Bytes),
+                    &Buffer,
+                    0
+                    );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  ZeroMem (Buffer, Bytes);
+
+  Status = PciIo->Map (
+                    PciIo,
+                    EfiPciIoOperationBusMasterCommonBuffer,
+                    Buffer,
+                    &Bytes,
+                    &PciAddr,
+                    &AhciRegisters->MapNcqCommandTable
+                    );
+  if (EFI_ERROR (Status) || (Bytes != AHCI_NCQ_MAX_DEPTH * sizeof (EFI_AHCI_NCQ_COMMAND_TABLE)) ||
+      (!Support64Bit && (PciAddr > 0x100000000ULL)))
+  {
+    if (!EFI_ERROR (Status)) {
+      PciIo->Unmap (PciIo, AhciRegisters->MapNcqCommandTable);
+    }
+
+    PciIo->FreeBuffer (
+             PciIo,
+             EFI_SIZE_TO_PAGES (AHCI_NCQ_MAX_DEPTH * sizeof (EFI_AHCI_NCQ_COMMAND_TABLE)),
+             Buffer
+             );
+    AhciRegisters->MapNcqCommandTable = NULL;
+    return;
+  }
+
+  AhciRegisters->AhciNcqCommandTable        = Buffer;
+  AhciRegisters->AhciNcqCommandTablePciAddr = (EFI_AHCI_NCQ_COMMAND_TABLE *)(UINTN)PciAddr;
+}
+
 /**
   Allocate transfer-related data struct which is used at AHCI mode.
 
@@ -2410,6 +2859,8 @@ AhciCreateTransferDescriptor (
 
   AhciRegisters->AhciCommandTablePciAddr = (EFI_AHCI_COMMAND_TABLE *)(UINTN)AhciCommandTablePciAddr;
 
+  AhciCreateNcqCommandTable (PciIo, AhciRegisters, Support64Bit);
+
   return EFI_SUCCESS;
   //
   // Map error or unable to map the whole CmdList buffer into a contiguous region.
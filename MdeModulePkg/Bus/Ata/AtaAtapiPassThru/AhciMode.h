@@ -14,6 +14,7 @@
 #define EFI_AHCI_CAPABILITY_OFFSET  0x0000
 #define   EFI_AHCI_CAP_SAM          BIT18
 #define   EFI_AHCI_CAP_SSS          BIT27
+#define   EFI_AHCI_CAP_SNCQ         BIT30
 #define   EFI_AHCI_CAP_S64A         BIT31
 #define EFI_AHCI_GHC_OFFSET         0x0004
 #define   EFI_AHCI_GHC_RESET        BIT0
@@ -62,6 +63,19 @@ typedef union {
 //
 #define EFI_AHCI_MAX_DATA_PER_PRDT  0x400000
 
+//
+// Native command queuing. Each queued command gets its own small command table
+// so that all command slots can be outstanding at the same time. A single read
+// or write is split into at most one command per slot, and every command is
+// kept at or above AHCI_NCQ_MIN_TRANSFER_SIZE bytes.
+//
+#define AHCI_NCQ_MAX_DEPTH          32
+#define AHCI_NCQ_PRDT_NUMBER        8
+#define AHCI_NCQ_MIN_TRANSFER_SIZE  0x10000
+#define ATA_CMD_READ_FPDMA_QUEUED   0x60
+#define ATA_CMD_WRITE_FPDMA_QUEUED  0x61
+#define ATA_FPDMA_DEVICE_LBA        BIT6
+
 #define EFI_AHCI_FIS_REGISTER_H2D           0x27         // Register FIS - Host to Device
 #define   EFI_AHCI_FIS_REGISTER_H2D_LENGTH  20
 #define EFI_AHCI_FIS_REGISTER_D2H           0x34         // Register FIS - Device to Host
@@ -286,6 +300,18 @@ typedef struct {
   EFI_AHCI_COMMAND_PRDT     PrdtTable[65535];     // The scatter/gather list for data transfer
 } EFI_AHCI_COMMAND_TABLE;
 
+//
+// Command table used by a queued command. It is laid out exactly like
+// EFI_AHCI_COMMAND_TABLE but with a short PRD table so that one table per
+// command slot can be allocated.
+//
+typedef struct {
+  EFI_AHCI_COMMAND_FIS      CommandFis;
+  EFI_AHCI_ATAPI_COMMAND    AtapiCmd;
+  UINT8                     Reserved[0x30];
+  EFI_AHCI_COMMAND_PRDT     PrdtTable[AHCI_NCQ_PRDT_NUMBER];
+} EFI_AHCI_NCQ_COMMAND_TABLE;
+
 //
 // Received FIS structure
 //
@@ -313,18 +339,21 @@ typedef struct {
 #pragma pack()
 
 typedef struct {
-  EFI_AHCI_RECEIVED_FIS     *AhciRFis;
-  EFI_AHCI_COMMAND_LIST     *AhciCmdList;
-  EFI_AHCI_COMMAND_TABLE    *AhciCommandTable;
-  EFI_AHCI_RECEIVED_FIS     *AhciRFisPciAddr;
-  EFI_AHCI_COMMAND_LIST     *AhciCmdListPciAddr;
-  EFI_AHCI_COMMAND_TABLE    *AhciCommandTablePciAddr;
-  UINT64                    MaxCommandListSize;
-  UINT64                    MaxCommandTableSize;
-  UINT64                    MaxReceiveFisSize;
-  VOID                      *MapRFis;
-  VOID                      *MapCmdList;
-  VOID                      *MapCommandTable;
+  EFI_AHCI_RECEIVED_FIS         *AhciRFis;
+  EFI_AHCI_COMMAND_LIST         *AhciCmdList;
+  EFI_AHCI_COMMAND_TABLE        *AhciCommandTable;
+  EFI_AHCI_RECEIVED_FIS         *AhciRFisPciAddr;
+  EFI_AHCI_COMMAND_LIST         *AhciCmdListPciAddr;
+  EFI_AHCI_COMMAND_TABLE        *AhciCommandTablePciAddr;
+  UINT64                        MaxCommandListSize;
+  UINT64                        MaxCommandTableSize;
+  UINT64                        MaxReceiveFisSize;
+  VOID                          *MapRFis;
+  VOID                          *MapCmdList;
+  VOID                          *MapCommandTable;
+  EFI_AHCI_NCQ_COMMAND_TABLE    *AhciNcqCommandTable;
+  EFI_AHCI_NCQ_COMMAND_TABLE    *AhciNcqCommandTablePciAddr;
+  VOID                          *MapNcqCommandTable;
 } EFI_AHCI_REGISTERS;
 
 /**
@@ -352,6 +381,27 @@ AhciPacketCommandExecute (
   IN  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
   );
 
+/**
+  Start the command list processing of a specific port, without issuing any
+  command slot.
+
+  @param  PciIo              The PCI IO protocol instance.
+  @param  Port               The number of port.
+  @param  Timeout            The timeout value of start, uses 100ns as a unit.
+
+  @retval EFI_DEVICE_ERROR   The port start unsuccessfully.
+  @retval EFI_TIMEOUT        The operation is time out.
+  @retval EFI_SUCCESS        The port start successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+AhciStartPort (
+  IN  EFI_PCI_IO_PROTOCOL  *PciIo,
+  IN  UINT8                Port,
+  IN  UINT64               Timeout
+  );
+
 /**
   Start command for give slot on specific port.
 
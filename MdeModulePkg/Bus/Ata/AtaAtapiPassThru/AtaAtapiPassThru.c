@@ -336,38 +336,76 @@ AtaPassThruPassThruExecute (
                      );
           break;
         case EFI_ATA_PASS_THRU_PROTOCOL_UDMA_DATA_IN:
-          Status = AhciDmaTransfer (
-                     Instance,
-                     &Instance->AhciRegisters,
-                     (UINT8)Port,
-                     (UINT8)PortMultiplierPort,
-                     NULL,
-                     0,
-                     TRUE,
-                     Packet->Acb,
-                     Packet->Asb,
-                     Packet->InDataBuffer,
-                     Packet->InTransferLength,
-                     Packet->Timeout,
-                     Task
-                     );
+          Status = EFI_UNSUPPORTED;
+          if (Task == NULL) {
+            Status = AhciNcqTransfer (
+                       Instance,
+                       &Instance->AhciRegisters,
+                       (UINT8)Port,
+                       (UINT8)PortMultiplierPort,
+                       TRUE,
+                       Packet->Acb,
+                       Packet->Asb,
+                       Packet->InDataBuffer,
+                       Packet->InTransferLength,
+                       Packet->Timeout
+                       );
+          }
+
+          if (Status == EFI_UNSUPPORTED) {
+            Status = AhciDmaTransfer (
+                       Instance,
+                       &Instance->AhciRegisters,
+                       (UINT8)Port,
+                       (UINT8)PortMultiplierPort,
+                       NULL,
+                       0,
+                       TRUE,
+                       Packet->Acb,
+                       Packet->Asb,
+                       Packet->InDataBuffer,
+                       Packet->InTransferLength,
+                       Packet->Timeout,
+                       Task
+                       );
+          }
+
           break;
         case EFI_ATA_PASS_THRU_PROTOCOL_UDMA_DATA_OUT:
-          Status = AhciDmaTransfer (
-                     Instance,
-                     &Instance->AhciRegisters,
-                     (UINT8)Port,
-                     (UINT8)PortMultiplierPort,
-                     NULL,
-                     0,
-                     FALSE,
-                     Packet->Acb,
-                     Packet->Asb,
-                     Packet->OutDataBuffer,
-                     Packet->OutTransferLength,
-                     Packet->Timeout,
-                     Task
-                     );
+          Status = EFI_UNSUPPORTED;
+          if (Task == NULL) {
+            Status = AhciNcqTransfer (
+                       Instance,
+                       &Instance->AhciRegisters,
+                       (UINT8)Port,
+                       (UINT8)PortMultiplierPort,
+                       FALSE,
+                       Packet->Acb,
+                       Packet->Asb,
+                       Packet->OutDataBuffer,
+                       Packet->OutTransferLength,
+                       Packet->Timeout
+                       );
+          }
+
+          if (Status == EFI_UNSUPPORTED) {
+            Status = AhciDmaTransfer (
+                       Instance,
+                       &Instance->AhciRegisters,
+                       (UINT8)Port,
+                       (UINT8)PortMultiplierPort,
+                       NULL,
+                       0,
+                       FALSE,
+                       Packet->Acb,
+                       Packet->Asb,
+                       Packet->OutDataBuffer,
+                       Packet->OutTransferLength,
+                       Packet->Timeout,
+                       Task
+                       );
+          }
+
           break;
         default:
           return EFI_UNSUPPORTED;
@@ -952,6 +990,18 @@ AtaAtapiPassThruStop (
   //
   if (Instance->Mode == EfiAtaAhciMode) {
     AhciRegisters = &Instance->AhciRegisters;
+    if (AhciRegisters->AhciNcqCommandTable != NULL) {
+      PciIo->Unmap (
+               PciIo,
+               AhciRegisters->MapNcqCommandTable
+               );
+      PciIo->FreeBuffer (
+               PciIo,
+               EFI_SIZE_TO_PAGES (AHCI_NCQ_MAX_DEPTH * sizeof (EFI_AHCI_NCQ_COMMAND_TABLE)),
+               AhciRegisters->AhciNcqCommandTable
+               );
+    }
+
     PciIo->Unmap (
              PciIo,
              AhciRegisters->MapCommandTable
@@ -699,16 +699,13 @@ ProcessAsyncTaskList (
           PciIo->Unmap (PciIo, AsyncRequest->MapMeta);
         }
 
-        if (AsyncRequest->MapPrpList != NULL) {
-          PciIo->Unmap (PciIo, AsyncRequest->MapPrpList);
-        }
-
         if (AsyncRequest->PrpListHost != NULL) {
-          PciIo->FreeBuffer (
-                   PciIo,
-                   AsyncRequest->PrpListNo,
-                   AsyncRequest->PrpListHost
-                   );
+          NvmeFreePrpList (
+            Private,
+            AsyncRequest->PrpListHost,
+            AsyncRequest->PrpListNo,
+            AsyncRequest->MapPrpList
+            );
         }
 
         RemoveEntryList (Link);
@@ -1067,6 +1064,42 @@ NvmExpressDriverBindingStart (
 
     Private->BufferPciAddr = (UINT8 *)(UINTN)MappedAddr;
 
+    //
+    // Allocate the pool of pages used as single page PRP lists. Commands
+    // allocate their PRP lists on demand if the pool is not available.
+    //
+    Status = PciIo->AllocateBuffer (
+                      PciIo,
+                      AllocateAnyPages,
+                      EfiBootServicesData,
+                      NVME_PRP_LIST_POOL_PAGES,
+                      (VOID **)&Private->PrpListPool,
+                      0
+                      );
+    if (!EFI_ERROR (Status)) {
+      Bytes  = EFI_PAGES_TO_SIZE (NVME_PRP_LIST_POOL_PAGES);
+      Status = PciIo->Map (
+                        PciIo,
+                        EfiPciIoOperationBusMasterCommonBuffer,
+                        Private->PrpListPool,
+                        &Bytes,
+                        &MappedAddr,
+                        &Private->PrpListPoolMapping
+                        );
+      if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (NVME_PRP_LIST_POOL_PAGES))) {
+        if (!EFI_ERROR (Status)) {
+          PciIo->Unmap (PciIo, Private->PrpListPoolMapping);
+        }
+
+        PciIo->FreeBuffer (PciIo, NVME_PRP_LIST_POOL_PAGES, Private->PrpListPool);
+        Private->PrpListPool        = NULL;
+        Private->PrpListPoolMapping = NULL;
+      } else {
+        Private->PrpListPoolPciAddr = (UINT8 *)(UINTN)MappedAddr;
+        Private->PrpListPoolFree    = MAX_UINT64;
+      }
+    }
+
     Private->Signature                 = NVME_CONTROLLER_PRIVATE_DATA_SIGNATURE;
     Private->ControllerHandle          = Controller;
     Private->ImageHandle               = This->DriverBindingHandle;
@@ -1174,6 +1207,11 @@ Exit:
     PciIo->FreeBuffer (PciIo, 6, Private->Buffer);
   }
 
+  if ((Private != NULL) && (Private->PrpListPool != NULL)) {
+    PciIo->Unmap (PciIo, Private->PrpListPoolMapping);
+    PciIo->FreeBuffer (PciIo, NVME_PRP_LIST_POOL_PAGES, Private->PrpListPool);
+  }
+
   if ((Private != NULL) && (Private->ControllerData != NULL)) {
     FreePool (Private->ControllerData);
   }
@@ -1296,6 +1334,11 @@ NvmExpressDriverBindingStop (
         Private->PciIo->FreeBuffer (Private->PciIo, 6, Private->Buffer);
       }
 
+      if (Private->PrpListPool != NULL) {
+        Private->PciIo->Unmap (Private->PciIo, Private->PrpListPoolMapping);
+        Private->PciIo->FreeBuffer (Private->PciIo, NVME_PRP_LIST_POOL_PAGES, Private->PrpListPool);
+      }
+
       FreePool (Private->ControllerData);
       FreePool (Private);
     }
@@ -80,6 +80,12 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gNvmExpressDriverSupportedEfiV
 
 #define NVME_MAX_QUEUES  3                              // Number of queues supported by the driver
 
+//
+// Number of pre-mapped pages kept for single page PRP lists, enough for a
+// full asynchronous I/O submission queue plus the blocking queues.
+//
+#define NVME_PRP_LIST_POOL_PAGES  64
+
 //
 // FormatNVM Admin Command LBA Format (LBAF) Mask
 //
@@ -186,6 +192,16 @@ struct _NVME_CONTROLLER_PRIVATE_DATA {
 
   VOID           *Mapping;
 
+  //
+  // Pool of pre-mapped pages used as single page PRP lists, so commands do
+  // not allocate and map a PRP list each time. A bit is set in
+  // PrpListPoolFree for each free page.
+  //
+  UINT8          *PrpListPool;
+  UINT8          *PrpListPoolPciAddr;
+  VOID           *PrpListPoolMapping;
+  UINT64         PrpListPoolFree;
+
   //
   // For Non-blocking operations.
   //
@@ -779,4 +795,78 @@ NvmeUnregisterShutdownNotification (
   VOID
   );
 
+/**
+  Free the PRP lists created by NvmeCreatePrpList().
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     PrpListHost         The host base address of PRP lists.
+  @param[in]     PrpListNo           The number of PRP List.
+  @param[in]     Mapping             The mapping value returned from PciIo.Map(), or NULL.
+
+**/
+VOID
+NvmeFreePrpList (
+  IN NVME_CONTROLLER_PRIVATE_DATA  *Private,
+  IN VOID                          *PrpListHost,
+  IN UINTN                         PrpListNo,
+  IN VOID                          *Mapping
+  );
+
+/**
+  Call back function when the timer event is signaled.
+
+  @param[in]  Event     The Event this notify function registered to.
+  @param[in]  Context   Pointer to the context data registered to the
+                        Event.
+
+**/
+VOID
+EFIAPI
+ProcessAsyncTaskList (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
+/**
+  Aborts the asynchronous PassThru requests.
+
+  @param[in] Private        The pointer to the NVME_CONTROLLER_PRIVATE_DATA
+                            data structure.
+
+  @retval EFI_SUCCESS       The asynchronous PassThru requests have been aborted.
+  @return EFI_DEVICE_ERROR  Fail to abort all the asynchronous PassThru requests.
+
+**/
+EFI_STATUS
+AbortAsyncPassThruTasks (
+  IN NVME_CONTROLLER_PRIVATE_DATA  *Private
+  );
+
+/**
+  Read or write some blocks in a blocking manner with several commands in
+  flight at a time.
+
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param  Read                   TRUE to read from the device, FALSE to write to it.
+  @param  Buffer                 The buffer used for the transfer.
+  @param  Lba                    The start block number.
+  @param  Blocks                 Total block number to be transferred.
+  @param  Commands               Number of commands the transfer is split into.
+
+  @retval EFI_SUCCESS            Datum are transferred.
+  @retval EFI_TIMEOUT            The commands did not complete in time and the
+                                 controller was reset.
+  @retval Others                 Fail to transfer all the datum.
+
+**/
+EFI_STATUS
+NvmeQueuedReadWrite (
+  IN     NVME_DEVICE_PRIVATE_DATA  *Device,
+  IN     BOOLEAN                   Read,
+  IN OUT VOID                      *Buffer,
+  IN     UINT64                    Lba,
+  IN     UINTN                     Blocks,
+  IN     UINTN                     Commands
+  );
+
 #endif
@@ -195,6 +195,33 @@ NvmeRead (
     MaxTransferBlocks = 1024;
   }
 
+  //
+  // Keep the commands of a multi-command transfer in flight together on the
+  // asynchronous I/O queue rather than issuing them one at a time.
+  //
+  if (Blocks > MaxTransferBlocks) {
+    Status = NvmeQueuedReadWrite (
+               Device,
+               TRUE,
+               Buffer,
+               Lba,
+               Blocks,
+               (Blocks + MaxTransferBlocks - 1) / MaxTransferBlocks
+               );
+
+    DEBUG ((
+      DEBUG_BLKIO,
+      "%a: Lba = 0x%08Lx, Blocks = 0x%08Lx, BlockSize = 0x%x, Status = %r\n",
+      __func__,
+      Lba,
+      (UINT64)OrginalBlocks,
+      BlockSize,
+      Status
+      ));
+
+    return Status;
+  }
+
   while (Blocks > 0) {
     if (Blocks > MaxTransferBlocks) {
       Status = ReadSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
@@ -281,6 +308,33 @@ NvmeWrite (
     MaxTransferBlocks = 1024;
   }
 
+  //
+  // Keep the commands of a multi-command transfer in flight together on the
+  // asynchronous I/O queue rather than issuing them one at a time.
+  //
+  if (Blocks > MaxTransferBlocks) {
+    Status = NvmeQueuedReadWrite (
+               Device,
+               FALSE,
+               Buffer,
+               Lba,
+               Blocks,
+               (Blocks + MaxTransferBlocks - 1) / MaxTransferBlocks
+               );
+
+    DEBUG ((
+      DEBUG_BLKIO,
+      "%a: Lba = 0x%08Lx, Blocks = 0x%08Lx, BlockSize = 0x%x, Status = %r\n",
+      __func__,
+      Lba,
+      (UINT64)OrginalBlocks,
+      BlockSize,
+      Status
+      ));
+
+    return Status;
+  }
+
   while (Blocks > 0) {
     if (Blocks > MaxTransferBlocks) {
       Status = WriteSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
@@ -956,6 +1010,116 @@ NvmeAsyncWrite (
   return Status;
 }
 
+/**
+  Read or write some blocks in a blocking manner with several commands in
+  flight at a time.
+
+  The transfer is queued as a BlockIo2 request on the asynchronous I/O queue,
+  and the asynchronous task list is processed directly while waiting rather
+  than on the periodic timer, so completed commands are reaped and pending
+  ones submitted as soon as there is room in the submission queue.
+
+  @param  Device                 The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param  Read                   TRUE to read from the device, FALSE to write to it.
+  @param  Buffer                 The buffer used for the transfer.
+  @param  Lba                    The start block number.
+  @param  Blocks                 Total block number to be transferred.
+  @param  Commands               Number of commands the transfer is split into.
+
+  @retval EFI_SUCCESS            Datum are transferred.
+  @retval EFI_TIMEOUT            The commands did not complete in time and the
+                                 controller was reset.
+  @retval Others                 Fail to transfer all the datum.
+
+**/
+EFI_STATUS
+NvmeQueuedReadWrite (
+  IN     NVME_DEVICE_PRIVATE_DATA  *Device,
+  IN     BOOLEAN                   Read,
+  IN OUT VOID                      *Buffer,
+  IN     UINT64                    Lba,
+  IN     UINTN                     Blocks,
+  IN     UINTN                     Commands
+  )
+{
+  NVME_CONTROLLER_PRIVATE_DATA  *Private;
+  EFI_BLOCK_IO2_TOKEN           Token;
+  EFI_EVENT                     TimerEvent;
+  EFI_TPL                       OldTpl;
+  EFI_STATUS                    Status;
+
+  Private    = Device->Controller;
+  TimerEvent = NULL;
+
+  ZeroMem (&Token, sizeof (EFI_BLOCK_IO2_TOKEN));
+  Status = gBS->CreateEvent (0, 0, NULL, NULL, &Token.Event);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &TimerEvent);
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  //
+  // Allow each command the timeout of a blocking command, as if they were
+  // issued one after another.
+  //
+  Status = gBS->SetTimer (TimerEvent, TimerRelative, MultU64x64 (NVME_GENERIC_TIMEOUT, Commands));
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  if (Read) {
+    Status = NvmeAsyncRead (Device, Buffer, Lba, Blocks, &Token);
+  } else {
+    Status = NvmeAsyncWrite (Device, Buffer, Lba, Blocks, &Token);
+  }
+
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
+
+  while (EFI_ERROR (gBS->CheckEvent (Token.Event))) {
+    if (!EFI_ERROR (gBS->CheckEvent (TimerEvent))) {
+      ReportStatusCode ((EFI_ERROR_MAJOR | EFI_ERROR_CODE), (EFI_IO_BUS_SCSI | EFI_IOB_EC_INTERFACE_ERROR));
+      DEBUG ((DEBUG_ERROR, "%a: Timeout occurs for queued NVMe commands.\n", __func__));
+
+      //
+      // Reset the NVMe controller to abort the outstanding commands, then
+      // complete the request so it no longer refers to the token.
+      //
+      gBS->SetTimer (Private->TimerEvent, TimerCancel, 0);
+      Status = NvmeControllerInit (Private);
+      AbortAsyncPassThruTasks (Private);
+      gBS->SetTimer (Private->TimerEvent, TimerPeriodic, NVME_HC_ASYNC_TIMER);
+
+      Status = EFI_ERROR (Status) ? EFI_DEVICE_ERROR : EFI_TIMEOUT;
+      goto Exit;
+    }
+
+    //
+    // The asynchronous I/O callbacks run at TPL_NOTIFY when the TPL is
+    // restored.
+    //
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    ProcessAsyncTaskList (NULL, Private);
+    gBS->RestoreTPL (OldTpl);
+  }
+
+  Status = Token.TransactionStatus;
+
+Exit:
+  if (TimerEvent != NULL) {
+    gBS->CloseEvent (TimerEvent);
+  }
+
+  gBS->CloseEvent (Token.Event);
+
+  return Status;
+}
+
 /**
   Reset the Block Device.
 
@@ -198,8 +198,10 @@ NvmeDumpStatus (
 /**
   Create PRP lists for data transfer which is larger than 2 memory pages.
   Note here we calcuate the number of required PRP lists and allocate them at one time.
+  A single PRP list is taken from the pre-mapped pool of the controller when
+  a page is free, in which case Mapping is set to NULL.
 
-  @param[in]     PciIo               A pointer to the EFI_PCI_IO_PROTOCOL instance.
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
   @param[in]     PhysicalAddr        The physical base address of data buffer.
   @param[in]     Pages               The number of pages to be transfered.
   @param[out]    PrpListHost         The host base address of PRP lists.
@@ -211,14 +213,15 @@ NvmeDumpStatus (
 **/
 VOID *
 NvmeCreatePrpList (
-  IN     EFI_PCI_IO_PROTOCOL   *PciIo,
-  IN     EFI_PHYSICAL_ADDRESS  PhysicalAddr,
-  IN     UINTN                 Pages,
-  OUT VOID                     **PrpListHost,
-  IN OUT UINTN                 *PrpListNo,
-  OUT VOID                     **Mapping
+  IN     NVME_CONTROLLER_PRIVATE_DATA  *Private,
+  IN     EFI_PHYSICAL_ADDRESS          PhysicalAddr,
+  IN     UINTN                         Pages,
+  OUT VOID                             **PrpListHost,
+  IN OUT UINTN                         *PrpListNo,
+  OUT VOID                             **Mapping
   )
 {
+  EFI_PCI_IO_PROTOCOL   *PciIo;
   UINTN                 PrpEntryNo;
   UINT64                PrpListBase;
   UINTN                 PrpListIndex;
@@ -226,8 +229,12 @@ NvmeCreatePrpList (
   UINT64                Remainder;
   EFI_PHYSICAL_ADDRESS  PrpListPhyAddr;
   UINTN                 Bytes;
+  UINTN                 PoolIndex;
+  EFI_TPL               OldTpl;
   EFI_STATUS            Status;
 
+  PciIo = Private->PciIo;
+
   //
   // The number of Prp Entry in a memory page.
   //
@@ -247,6 +254,26 @@ NvmeCreatePrpList (
     Remainder = PrpEntryNo - 1;
   }
 
+  *PrpListHost = NULL;
+  *Mapping     = NULL;
+  Bytes        = EFI_PAGES_TO_SIZE (*PrpListNo);
+
+  if ((*PrpListNo == 1) && (Private->PrpListPool != NULL)) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if (Private->PrpListPoolFree != 0) {
+      PoolIndex                 = (UINTN)LowBitSet64 (Private->PrpListPoolFree);
+      Private->PrpListPoolFree &= ~LShiftU64 (1, PoolIndex);
+      *PrpListHost              = Private->PrpListPool + EFI_PAGES_TO_SIZE (PoolIndex);
+      PrpListPhyAddr            = (EFI_PHYSICAL_ADDRESS)(UINTN)(Private->PrpListPoolPciAddr + EFI_PAGES_TO_SIZE (PoolIndex));
+    }
+
+    gBS->RestoreTPL (OldTpl);
+
+    if (*PrpListHost != NULL) {
+      goto FILL;
+    }
+  }
+
   Status = PciIo->AllocateBuffer (
                     PciIo,
                     AllocateAnyPages,
@@ -260,7 +287,6 @@ NvmeCreatePrpList (
     return NULL;
   }
 
-  Bytes  = EFI_PAGES_TO_SIZE (*PrpListNo);
   Status = PciIo->Map (
                     PciIo,
                     EfiPciIoOperationBusMasterCommonBuffer,
@@ -275,6 +301,7 @@ NvmeCreatePrpList (
     goto EXIT;
   }
 
+FILL:
   //
   // Fill all PRP lists except of last one.
   //
@@ -314,6 +341,45 @@ EXIT:
   return NULL;
 }
 
+/**
+  Free the PRP lists created by NvmeCreatePrpList().
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     PrpListHost         The host base address of PRP lists.
+  @param[in]     PrpListNo           The number of PRP List.
+  @param[in]     Mapping             The mapping value returned from PciIo.Map(), or NULL.
+
+**/
+VOID
+NvmeFreePrpList (
+  IN NVME_CONTROLLER_PRIVATE_DATA  *Private,
+  IN VOID                          *PrpListHost,
+  IN UINTN                         PrpListNo,
+  IN VOID                          *Mapping
+  )
+{
+  UINTN    PoolIndex;
+  EFI_TPL  OldTpl;
+
+  if ((Private->PrpListPool != NULL) &&
+      ((UINT8 *)PrpListHost >= Private->PrpListPool) &&
+      ((UINT8 *)PrpListHost < Private->PrpListPool + EFI_PAGES_TO_SIZE (NVME_PRP_LIST_POOL_PAGES)))
+  {
+    PoolIndex = EFI_SIZE_TO_PAGES ((UINTN)((UINT8 *)PrpListHost - Private->PrpListPool));
+
+    OldTpl                    = gBS->RaiseTPL (TPL_NOTIFY);
+    Private->PrpListPoolFree |= LShiftU64 (1, PoolIndex);
+    gBS->RestoreTPL (OldTpl);
+    return;
+  }
+
+  if (Mapping != NULL) {
+    Private->PciIo->Unmap (Private->PciIo, Mapping);
+  }
+
+  Private->PciIo->FreeBuffer (Private->PciIo, PrpListNo, PrpListHost);
+}
+
 /**
   Aborts the asynchronous PassThru requests.
 
@@ -384,16 +450,13 @@ AbortAsyncPassThruTasks (
       PciIo->Unmap (PciIo, AsyncRequest->MapMeta);
     }
 
-    if (AsyncRequest->MapPrpList != NULL) {
-      PciIo->Unmap (PciIo, AsyncRequest->MapPrpList);
-    }
-
     if (AsyncRequest->PrpListHost != NULL) {
-      PciIo->FreeBuffer (
-               PciIo,
-               AsyncRequest->PrpListNo,
-               AsyncRequest->PrpListHost
-               );
+      NvmeFreePrpList (
+        Private,
+        AsyncRequest->PrpListHost,
+        AsyncRequest->PrpListNo,
+        AsyncRequest->MapPrpList
+        );
     }
 
     RemoveEntryList (Link);
@@ -479,6 +542,7 @@ NvmExpressPassThru (
   UINT32                         IoAlign;
   UINT32                         MaxTransLen;
   UINT32                         Data;
+  UINT32                         SglSupport;
   NVME_PASS_THRU_ASYNC_REQ       *AsyncRequest;
   EFI_TPL                        OldTpl;
 
@@ -588,7 +652,8 @@ NvmExpressPassThru (
   Sq->Nsid = Packet->NvmeCmd->Nsid;
 
   //
-  // Currently we only support PRP for data transfer, SGL is NOT supported.
+  // PRP is used for data transfer, except for the reads and writes which are
+  // described with a SGL below.
   //
   ASSERT (Sq->Psdt == 0);
   if (Sq->Psdt != 0) {
@@ -672,15 +737,38 @@ NvmExpressPassThru (
   // If the buffer size spans more than two memory pages (page size as defined in CC.Mps),
   // then build a PRP list in the second PRP submission queue entry.
   //
-  Offset = ((UINT16)Sq->Prp[0]) & (EFI_PAGE_SIZE - 1);
-  Bytes  = Packet->TransferLength;
+  Offset     = ((UINT16)Sq->Prp[0]) & (EFI_PAGE_SIZE - 1);
+  Bytes      = Packet->TransferLength;
+  SglSupport = Private->ControllerData->Sgls & (BIT0 | BIT1);
+
+  if ((MapData != NULL) &&
+      (Packet->QueueType == NVME_IO_QUEUE) &&
+      ((Sq->Opc == NVME_IO_READ_OPC) || (Sq->Opc == NVME_IO_WRITE_OPC)) &&
+      ((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) &&
+      ((SglSupport == BIT0) || ((SglSupport == BIT1) && (((Sq->Prp[0] | Bytes) & 0x3) == 0))))
+  {
+    //
+    // The mapped data buffer is contiguous, so when the controller supports
+    // SGLs for the NVM command set a single SGL Data Block descriptor covers
+    // it instead of a PRP list with an entry per page.
+    //
+    // PSDT 01b: SGLs are used for the data transfer and MPTR holds the address
+    // of a contiguous metadata buffer. NVME_SQ only names bit 15 of PSDT as
+    // Psdt, bit 14 is the top bit of Rsvd1.
+    //
+    Sq->Rsvd1 |= BIT4;
 
-  if ((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) {
+    //
+    // The descriptor address is already in the first 8 bytes, then come the
+    // length and the SGL identifier (Data Block, 0h) in the last byte.
+    //
+    Sq->Prp[1] = Bytes;
+  } else if ((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) {
     //
     // Create PrpList for remaining data buffer.
     //
     PhyAddr = (Sq->Prp[0] + EFI_PAGE_SIZE) & ~(EFI_PAGE_SIZE - 1);
-    Prp     = NvmeCreatePrpList (PciIo, PhyAddr, EFI_SIZE_TO_PAGES (Offset + Bytes) - 1, &PrpListHost, &PrpListNo, &MapPrpList);
+    Prp     = NvmeCreatePrpList (Private, PhyAddr, EFI_SIZE_TO_PAGES (Offset + Bytes) - 1, &PrpListHost, &PrpListNo, &MapPrpList);
     if (Prp == NULL) {
       Status = EFI_OUT_OF_RESOURCES;
       goto EXIT;
@@ -907,17 +995,15 @@ EXIT:
              );
   }
 
-  if (MapPrpList != NULL) {
+  if (Prp != NULL) {
+    NvmeFreePrpList (Private, PrpListHost, PrpListNo, MapPrpList);
+  } else if (MapPrpList != NULL) {
     PciIo->Unmap (
              PciIo,
              MapPrpList
              );
   }
 
-  if (Prp != NULL) {
-    PciIo->FreeBuffer (PciIo, PrpListNo, PrpListHost);
-  }
-
   if (TimerEvent != NULL) {
     gBS->CloseEvent (TimerEvent);
   }
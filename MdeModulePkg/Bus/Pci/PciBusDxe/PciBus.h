@@ -38,6 +38,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/PcdLib.h>
+#include <Library/PerformanceLib.h>
 
 #include <IndustryStandard/Pci.h>
 #include <IndustryStandard/PeImage.h>
@@ -151,6 +152,18 @@ struct _PCI_BAR {
 
 #define PCI_MAX_HOST_BRIDGE_NUM  0x0010
 
+//
+// Number of capability headers shadowed per device
+//
+#define PCI_CAPABILITY_SHADOW_SIZE          16
+#define PCI_EXPRESS_CAPABILITY_SHADOW_SIZE  32
+
+typedef struct {
+  UINT16    CapabilityId;
+  UINT16    Offset;
+  UINT16    NextOffset;
+} PCI_CAPABILITY_SHADOW;
+
 //
 // Define option for attribute
 //
@@ -282,6 +295,20 @@ struct _PCI_IO_DEVICE {
   UINT16                                       BridgeIoAlignment;
   UINT32                                       ResizableBarOffset;
   UINT32                                       ResizableBarNumber;
+
+  //
+  // Shadow of the (extended) capability list headers, filled by the first
+  // capability lookup. The headers are read-only so no invalidation is needed.
+  // A shadow that could not be filled is not attempted again.
+  //
+  BOOLEAN                                      CapabilityShadowAttempted;
+  BOOLEAN                                      CapabilityShadowValid;
+  UINT8                                        CapabilityShadowCount;
+  PCI_CAPABILITY_SHADOW                        CapabilityShadow[PCI_CAPABILITY_SHADOW_SIZE];
+  BOOLEAN                                      ExpressCapabilityShadowAttempted;
+  BOOLEAN                                      ExpressCapabilityShadowValid;
+  UINT8                                        ExpressCapabilityShadowCount;
+  PCI_CAPABILITY_SHADOW                        ExpressCapabilityShadow[PCI_EXPRESS_CAPABILITY_SHADOW_SIZE];
 };
 
 #define PCI_IO_DEVICE_FROM_PCI_IO_THIS(a) \
@@ -8,6 +8,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "PciBus.h"
 
+UINTN  gPciCapabilityConfigReads = 0;
+UINTN  gPciCapabilityShadowHits  = 0;
+
 /**
   Operate the PCI register via PciIo function interface.
 
@@ -89,6 +92,191 @@ PciCapabilitySupport (
   return FALSE;
 }
 
+/**
+  Search the capability header shadow of a device.
+
+  @param Shadow            The capability header shadow.
+  @param Count             Number of entries in Shadow.
+  @param CapId             The capability ID.
+  @param StartOffset       Offset of the capability to start with, 0 for the list head.
+  @param Offset            A pointer to the offset returned.
+  @param NextRegBlock      A pointer to the next block returned.
+
+  @retval EFI_SUCCESS      Successfully located capability register block.
+  @retval EFI_NOT_FOUND    The capability is not in the list.
+  @retval EFI_NO_MAPPING   StartOffset is not the offset of a capability in the list.
+
+**/
+STATIC
+EFI_STATUS
+PciSearchCapabilityShadow (
+  IN  PCI_CAPABILITY_SHADOW  *Shadow,
+  IN  UINTN                  Count,
+  IN  UINT16                 CapId,
+  IN  UINT32                 StartOffset,
+  OUT UINT32                 *Offset,
+  OUT UINT32                 *NextRegBlock
+  )
+{
+  UINTN  Index;
+
+  Index = 0;
+  if (StartOffset != 0) {
+    while ((Index < Count) && (Shadow[Index].Offset != StartOffset)) {
+      Index++;
+    }
+
+    if (Index == Count) {
+      return EFI_NO_MAPPING;
+    }
+  }
+
+  gPciCapabilityShadowHits++;
+  for ( ; Index < Count; Index++) {
+    if (Shadow[Index].CapabilityId == CapId) {
+      *Offset       = Shadow[Index].Offset;
+      *NextRegBlock = Shadow[Index].NextOffset;
+      return EFI_SUCCESS;
+    }
+  }
+
+  return EFI_NOT_FOUND;
+}
+
+/**
+  Walk the capability list of a device once and shadow all capability headers.
+
+  The shadow is left invalid when the list is longer than the shadow, so the
+  lookups walk the list in config space for such devices without trying to
+  shadow it again.
+
+  @param PciIoDevice       A pointer to the PCI_IO_DEVICE.
+
+**/
+STATIC
+VOID
+PciShadowCapabilityList (
+  IN PCI_IO_DEVICE  *PciIoDevice
+  )
+{
+  UINT8   CapabilityPtr;
+  UINT16  CapabilityEntry;
+  UINT8   Count;
+
+  PciIoDevice->CapabilityShadowAttempted = TRUE;
+
+  CapabilityPtr = 0;
+  if (IS_CARDBUS_BRIDGE (&PciIoDevice->Pci)) {
+    PciIoDevice->PciIo.Pci.Read (
+                             &PciIoDevice->PciIo,
+                             EfiPciIoWidthUint8,
+                             EFI_PCI_CARDBUS_BRIDGE_CAPABILITY_PTR,
+                             1,
+                             &CapabilityPtr
+                             );
+  } else {
+    PciIoDevice->PciIo.Pci.Read (
+                             &PciIoDevice->PciIo,
+                             EfiPciIoWidthUint8,
+                             PCI_CAPBILITY_POINTER_OFFSET,
+                             1,
+                             &CapabilityPtr
+                             );
+  }
+
+  gPciCapabilityConfigReads++;
+
+  Count = 0;
+  while ((CapabilityPtr >= 0x40) && ((CapabilityPtr & 0x03) == 0x00)) {
+    if (Count == PCI_CAPABILITY_SHADOW_SIZE) {
+      return;
+    }
+
+    PciIoDevice->PciIo.Pci.Read (
+                             &PciIoDevice->PciIo,
+                             EfiPciIoWidthUint16,
+                             CapabilityPtr,
+                             1,
+                             &CapabilityEntry
+                             );
+    gPciCapabilityConfigReads++;
+
+    PciIoDevice->CapabilityShadow[Count].CapabilityId = (UINT8)CapabilityEntry;
+    PciIoDevice->CapabilityShadow[Count].Offset       = CapabilityPtr;
+    PciIoDevice->CapabilityShadow[Count].NextOffset   = (UINT8)(CapabilityEntry >> 8);
+    Count++;
+
+    //
+    // Certain PCI device may incorrectly have capability pointing to itself,
+    // stop to avoid dead loop.
+    //
+    if (CapabilityPtr == (UINT8)(CapabilityEntry >> 8)) {
+      break;
+    }
+
+    CapabilityPtr = (UINT8)(CapabilityEntry >> 8);
+  }
+
+  PciIoDevice->CapabilityShadowCount = Count;
+  PciIoDevice->CapabilityShadowValid = TRUE;
+}
+
+/**
+  Walk the PCI Express extended capability list of a device once and shadow all
+  extended capability headers.
+
+  The shadow is left invalid when the list is longer than the shadow or the
+  config space cannot be accessed, so the lookups walk the list in config
+  space for such devices without trying to shadow it again.
+
+  @param PciIoDevice       A pointer to the PCI_IO_DEVICE.
+
+**/
+STATIC
+VOID
+PciShadowExpressCapabilityList (
+  IN PCI_IO_DEVICE  *PciIoDevice
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      CapabilityPtr;
+  UINT32      CapabilityEntry;
+  UINT8       Count;
+
+  PciIoDevice->ExpressCapabilityShadowAttempted = TRUE;
+
+  Count         = 0;
+  CapabilityPtr = EFI_PCIE_CAPABILITY_BASE_OFFSET;
+  while (CapabilityPtr != 0) {
+    if (Count == PCI_EXPRESS_CAPABILITY_SHADOW_SIZE) {
+      return;
+    }
+
+    CapabilityPtr &= 0xFFC;
+    Status         = PciIoDevice->PciIo.Pci.Read (
+                                              &PciIoDevice->PciIo,
+                                              EfiPciIoWidthUint32,
+                                              CapabilityPtr,
+                                              1,
+                                              &CapabilityEntry
+                                              );
+    gPciCapabilityConfigReads++;
+    if (EFI_ERROR (Status) || (CapabilityEntry == MAX_UINT32)) {
+      return;
+    }
+
+    PciIoDevice->ExpressCapabilityShadow[Count].CapabilityId = (UINT16)CapabilityEntry;
+    PciIoDevice->ExpressCapabilityShadow[Count].Offset       = (UINT16)CapabilityPtr;
+    PciIoDevice->ExpressCapabilityShadow[Count].NextOffset   = (UINT16)((CapabilityEntry >> 20) & 0xFFF);
+    Count++;
+
+    CapabilityPtr = (CapabilityEntry >> 20) & 0xFFF;
+  }
+
+  PciIoDevice->ExpressCapabilityShadowCount = Count;
+  PciIoDevice->ExpressCapabilityShadowValid = TRUE;
+}
+
 /**
   Locate capability register block per capability ID.
 
@@ -110,9 +298,12 @@ LocateCapabilityRegBlock (
   OUT UINT8         *NextRegBlock OPTIONAL
   )
 {
-  UINT8   CapabilityPtr;
-  UINT16  CapabilityEntry;
-  UINT8   CapabilityID;
+  EFI_STATUS  Status;
+  UINT8       CapabilityPtr;
+  UINT16      CapabilityEntry;
+  UINT8       CapabilityID;
+  UINT32      ShadowOffset;
+  UINT32      ShadowNext;
 
   //
   // To check the capability of this device supports
@@ -121,6 +312,31 @@ LocateCapabilityRegBlock (
     return EFI_UNSUPPORTED;
   }
 
+  if (!PciIoDevice->CapabilityShadowAttempted) {
+    PciShadowCapabilityList (PciIoDevice);
+  }
+
+  if (PciIoDevice->CapabilityShadowValid) {
+    Status = PciSearchCapabilityShadow (
+               PciIoDevice->CapabilityShadow,
+               PciIoDevice->CapabilityShadowCount,
+               CapId,
+               *Offset,
+               &ShadowOffset,
+               &ShadowNext
+               );
+    if (Status != EFI_NO_MAPPING) {
+      if (!EFI_ERROR (Status)) {
+        *Offset = (UINT8)ShadowOffset;
+        if (NextRegBlock != NULL) {
+          *NextRegBlock = (UINT8)ShadowNext;
+        }
+      }
+
+      return Status;
+    }
+  }
+
   if (*Offset != 0) {
     CapabilityPtr = *Offset;
   } else {
@@ -152,6 +368,7 @@ LocateCapabilityRegBlock (
                              1,
                              &CapabilityEntry
                              );
+    gPciCapabilityConfigReads++;
 
     CapabilityID = (UINT8)CapabilityEntry;
 
@@ -203,6 +420,8 @@ LocatePciExpressCapabilityRegBlock (
   UINT32      CapabilityPtr;
   UINT32      CapabilityEntry;
   UINT16      CapabilityID;
+  UINT32      ShadowOffset;
+  UINT32      ShadowNext;
 
   //
   // To check the capability of this device supports
@@ -211,6 +430,31 @@ LocatePciExpressCapabilityRegBlock (
     return EFI_UNSUPPORTED;
   }
 
+  if (!PciIoDevice->ExpressCapabilityShadowAttempted) {
+    PciShadowExpressCapabilityList (PciIoDevice);
+  }
+
+  if (PciIoDevice->ExpressCapabilityShadowValid) {
+    Status = PciSearchCapabilityShadow (
+               PciIoDevice->ExpressCapabilityShadow,
+               PciIoDevice->ExpressCapabilityShadowCount,
+               CapId,
+               *Offset & 0xFFC,
+               &ShadowOffset,
+               &ShadowNext
+               );
+    if (Status != EFI_NO_MAPPING) {
+      if (!EFI_ERROR (Status)) {
+        *Offset = ShadowOffset;
+        if (NextRegBlock != NULL) {
+          *NextRegBlock = ShadowNext;
+        }
+      }
+
+      return Status;
+    }
+  }
+
   if (*Offset != 0) {
     CapabilityPtr = *Offset;
   } else {
@@ -229,6 +473,7 @@ LocatePciExpressCapabilityRegBlock (
                                               1,
                                               &CapabilityEntry
                                               );
+    gPciCapabilityConfigReads++;
     if (EFI_ERROR (Status)) {
       break;
     }
@@ -54,6 +54,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define EFI_ENABLE_REGISTER   3
 #define EFI_DISABLE_REGISTER  4
 
+//
+// Statistics of the capability lookups
+//
+extern UINTN  gPciCapabilityConfigReads;
+extern UINTN  gPciCapabilityShadowHits;
+
 /**
   Operate the PCI register via PciIo function interface.
 
@@ -329,7 +329,9 @@ RegisterPciDevice (
     // or loaded from device in the previous round of bus enumeration
     //
     if (HasEfiImage) {
+      PERF_INMODULE_BEGIN ("ProcessOpRomImage");
       ProcessOpRomImage (PciIoDevice);
+      PERF_INMODULE_END ("ProcessOpRomImage");
     }
   }
 
@@ -98,6 +98,13 @@ PciEnumerator (
     return Status;
   }
 
+  DEBUG ((
+    DEBUG_INFO,
+    "PCI capability lookups: %Lu config reads, %Lu served from shadow\n",
+    (UINT64)gPciCapabilityConfigReads,
+    (UINT64)gPciCapabilityShadowHits
+    ));
+
   return EFI_SUCCESS;
 }
 
@@ -303,7 +310,9 @@ ProcessOptionRom (
       //
       // Load and process the option rom
       //
+      PERF_INMODULE_BEGIN ("LoadOpRomImage");
       LoadOpRomImage (Temp, RomBase);
+      PERF_INMODULE_END ("LoadOpRomImage");
     }
 
     CurrentLink = CurrentLink->ForwardLink;
@@ -1064,6 +1064,46 @@ PciAllocateBusNumber (
   return EFI_OUT_OF_RESOURCES;
 }
 
+/**
+  Check whether the secondary bus of a PCI bridge can only host device 0.
+
+  The link below a PCIe Root Port or Switch Downstream Port connects to exactly
+  one device, so device numbers 1-31 on its secondary bus never respond unless
+  ARI reuses them as function numbers of device 0.
+
+  @param  Bridge           Bridge device instance.
+
+  @retval TRUE             Only device 0 needs to be probed below Bridge.
+  @retval FALSE            All devices need to be probed below Bridge.
+
+**/
+BOOLEAN
+PciBridgeHasSingleDevice (
+  IN PCI_IO_DEVICE  *Bridge
+  )
+{
+  EFI_STATUS               Status;
+  PCI_REG_PCIE_CAPABILITY  Capability;
+
+  if (!Bridge->IsPciExp) {
+    return FALSE;
+  }
+
+  Status = Bridge->PciIo.Pci.Read (
+                               &Bridge->PciIo,
+                               EfiPciIoWidthUint16,
+                               Bridge->PciExpressCapabilityOffset + OFFSET_OF (PCI_CAPABILITY_PCIEXP, Capability),
+                               1,
+                               &Capability
+                               );
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)((Capability.Bits.DevicePortType == PCIE_DEVICE_PORT_TYPE_ROOT_PORT) ||
+                   (Capability.Bits.DevicePortType == PCIE_DEVICE_PORT_TYPE_DOWNSTREAM_PORT));
+}
+
 /**
   Scan pci bus and assign bus number to the given PCI bus system.
 
@@ -1108,6 +1148,7 @@ PciScanBus (
   BOOLEAN                            BusPadding;
   UINT32                             TempReservedBusNum;
   BOOLEAN                            IsAriEnabled;
+  BOOLEAN                            SingleDevice;
 
   PciRootBridgeIo   = Bridge->PciRootBridgeIo;
   SecondBus         = 0;
@@ -1120,8 +1161,16 @@ PciScanBus (
   PciAddress        = 0;
   IsAriEnabled      = FALSE;
   DescriptorsBuffer = NULL;
+  SingleDevice      = PciBridgeHasSingleDevice (Bridge);
 
   for (Device = 0; Device <= PCI_MAX_DEVICE; Device++) {
+    if ((Device != 0) && SingleDevice && !IsAriEnabled) {
+      //
+      // Skip the config cycles to device 1-31 which cannot exist below a PCIe port
+      //
+      break;
+    }
+
     if (!IsAriEnabled) {
       TempReservedBusNum = 0;
     }
@@ -1593,10 +1642,12 @@ PciHostBridgeEnumerator (
     //
     // Enumerate all the buses under this root bridge
     //
+    PERF_START (RootBridgeHandle, "PciRootBridgeEnum", "PciBusDxe", 0);
     Status = PciRootBridgeEnumerator (
                PciResAlloc,
                RootBridgeDev
                );
+    PERF_END (RootBridgeHandle, "PciRootBridgeEnum", "PciBusDxe", 0);
 
     if ((gPciHotPlugInit != NULL) && FeaturePcdGet (PcdPciBusHotplugDeviceSupport)) {
       InsertTailList (&RootBridgeList, &(RootBridgeDev->Link));
@@ -1689,10 +1740,12 @@ PciHostBridgeEnumerator (
       //
       // Enumerate all the buses under this root bridge
       //
+      PERF_START (RootBridgeHandle, "PciRootBridgeEnum", "PciBusDxe", 0);
       Status = PciRootBridgeEnumerator (
                  PciResAlloc,
                  RootBridgeDev
                  );
+      PERF_END (RootBridgeHandle, "PciRootBridgeEnum", "PciBusDxe", 0);
 
       DestroyRootBridge (RootBridgeDev);
       if (EFI_ERROR (Status)) {
@@ -92,6 +92,20 @@ PciAllocateBusNumber (
   OUT UINT8         *NextBusNumber
   );
 
+/**
+  Check whether the secondary bus of a PCI bridge can only host device 0.
+
+  @param  Bridge           Bridge device instance.
+
+  @retval TRUE             Only device 0 needs to be probed below Bridge.
+  @retval FALSE            All devices need to be probed below Bridge.
+
+**/
+BOOLEAN
+PciBridgeHasSingleDevice (
+  IN PCI_IO_DEVICE  *Bridge
+  );
+
 /**
   Scan pci bus and assign bus number to the given PCI bus system.
 
@@ -423,9 +423,10 @@ LoadOpRomImage (
   }
 
   //
-  // Allocate memory for Rom header and PCIR
+  // Allocate memory for Rom header and PCIR.
+  // Round the header up to DWORD so both can be read with DWORD accesses.
   //
-  RomHeader = AllocatePool (sizeof (PCI_EXPANSION_ROM_HEADER));
+  RomHeader = AllocatePool (ALIGN_VALUE (sizeof (PCI_EXPANSION_ROM_HEADER), sizeof (UINT32)));
   if (RomHeader == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -451,9 +452,9 @@ LoadOpRomImage (
   do {
     PciDevice->PciRootBridgeIo->Mem.Read (
                                       PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
+                                      EfiPciWidthUint32,
                                       RomBarOffset,
-                                      sizeof (PCI_EXPANSION_ROM_HEADER),
+                                      ALIGN_VALUE (sizeof (PCI_EXPANSION_ROM_HEADER), sizeof (UINT32)) / sizeof (UINT32),
                                       (UINT8 *)RomHeader
                                       );
 
@@ -482,9 +483,9 @@ LoadOpRomImage (
 
     PciDevice->PciRootBridgeIo->Mem.Read (
                                       PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
+                                      EfiPciWidthUint32,
                                       RomBarOffset + OffsetPcir,
-                                      sizeof (PCI_DATA_STRUCTURE),
+                                      sizeof (PCI_DATA_STRUCTURE) / sizeof (UINT32),
                                       (UINT8 *)RomPcir
                                       );
     //
@@ -324,6 +324,98 @@ CalculateApertureIo16 (
   Bridge->Length = MAX (Bridge->Length, PaddingAperture);
 }
 
+/**
+  Record an unused hole in a bridge aperture.
+
+  The hole is dropped when the table is full, which only makes the
+  packing less tight.
+
+  @param Gap         The table of unused holes.
+  @param GapCount    Number of holes in the table.
+  @param Base        Offset of the hole.
+  @param Length      Length of the hole.
+
+**/
+STATIC
+VOID
+AddResourceGap (
+  IN OUT PCI_RESOURCE_GAP  *Gap,
+  IN OUT UINTN             *GapCount,
+  IN     UINT64            Base,
+  IN     UINT64            Length
+  )
+{
+  if ((Length == 0) || (*GapCount == PCI_RESOURCE_GAP_MAX)) {
+    return;
+  }
+
+  Gap[*GapCount].Base   = Base;
+  Gap[*GapCount].Length = Length;
+  (*GapCount)++;
+}
+
+/**
+  Assign the offset of a resource within a bridge aperture.
+
+  The resource is placed into the first hole left by the alignment of
+  previously placed resources that can hold it, and appended at the end
+  of the aperture otherwise.
+
+  @param Gap         The table of unused holes.
+  @param GapCount    Number of holes in the table.
+  @param Aperture    Current end of the aperture.
+  @param Length      Length of the resource.
+  @param Alignment   Alignment mask of the resource.
+
+  @return The offset of the resource.
+
+**/
+STATIC
+UINT64
+AllocateResourceOffset (
+  IN OUT PCI_RESOURCE_GAP  *Gap,
+  IN OUT UINTN             *GapCount,
+  IN OUT UINT64            *Aperture,
+  IN     UINT64            Length,
+  IN     UINT64            Alignment
+  )
+{
+  UINTN   Index;
+  UINT64  Base;
+  UINT64  Offset;
+  UINT64  End;
+
+  for (Index = 0; Index < *GapCount; Index++) {
+    Base   = Gap[Index].Base;
+    End    = Base + Gap[Index].Length;
+    Offset = ALIGN_VALUE (Base, Alignment + 1);
+    if ((Offset >= End) || (Length > End - Offset)) {
+      continue;
+    }
+
+    //
+    // Replace the hole by the space after the resource and keep the
+    // space before it.
+    //
+    if (Offset + Length == End) {
+      (*GapCount)--;
+      Gap[Index] = Gap[*GapCount];
+    } else {
+      Gap[Index].Base   = Offset + Length;
+      Gap[Index].Length = End - Offset - Length;
+    }
+
+    AddResourceGap (Gap, GapCount, Base, Offset - Base);
+    return Offset;
+  }
+
+  Offset = ALIGN_VALUE (*Aperture, Alignment + 1);
+  AddResourceGap (Gap, GapCount, *Aperture, Offset - *Aperture);
+  *Aperture = Offset + Length;
+
+  return Offset;
+}
+
 /**
   This function is used to calculate the resource aperture
   for a given bridge device.
@@ -337,6 +429,8 @@ CalculateResourceAperture (
   )
 {
   UINT64             Aperture[2];
+  PCI_RESOURCE_GAP   Gap[2][PCI_RESOURCE_GAP_MAX];
+  UINTN              GapCount[2];
   LIST_ENTRY         *CurrentLink;
   PCI_RESOURCE_NODE  *Node;
 
@@ -351,6 +445,8 @@ CalculateResourceAperture (
 
   Aperture[PciResUsageTypical] = 0;
   Aperture[PciResUsagePadding] = 0;
+  GapCount[PciResUsageTypical] = 0;
+  GapCount[PciResUsagePadding] = 0;
   //
   // Assume the bridge is aligned
   //
@@ -372,15 +468,18 @@ CalculateResourceAperture (
     ASSERT (Node->ResourceUsage < ARRAY_SIZE (Aperture));
     //
     // Recode current aperture as a offset
-    // Apply padding resource to meet alignment requirement
+    // Fill the holes left by the alignment of the previous nodes first,
+    // so the bridges with a length that is not a multiple of their
+    // alignment do not grow the aperture of their parent.
     // Node offset will be used in future real allocation
     //
-    Node->Offset = ALIGN_VALUE (Aperture[Node->ResourceUsage], Node->Alignment + 1);
-
-    //
-    // Record the total aperture.
-    //
-    Aperture[Node->ResourceUsage] = Node->Offset + Node->Length;
+    Node->Offset = AllocateResourceOffset (
+                     Gap[Node->ResourceUsage],
+                     &GapCount[Node->ResourceUsage],
+                     &Aperture[Node->ResourceUsage],
+                     Node->Length,
+                     Node->Alignment
+                     );
   }
 
   //
@@ -34,6 +34,17 @@ typedef struct {
 #define RESOURCE_NODE_FROM_LINK(a) \
   CR (a, PCI_RESOURCE_NODE, Link, PCI_RESOURCE_SIGNATURE)
 
+//
+// Maximum number of alignment holes tracked per aperture while packing the
+// resources of a bridge.
+//
+#define PCI_RESOURCE_GAP_MAX  8
+
+typedef struct {
+  UINT64    Base;
+  UINT64    Length;
+} PCI_RESOURCE_GAP;
+
 /**
   The function is used to skip VGA range.
 
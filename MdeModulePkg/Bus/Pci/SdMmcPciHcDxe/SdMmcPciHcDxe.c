@@ -857,6 +857,10 @@ Done:
                );
     }
 
+    if (Private != NULL) {
+      SdMmcFreeAdmaDescCache (Private);
+    }
+
     gBS->CloseProtocol (
            Controller,
            &gEfiPciIoProtocolGuid,
@@ -980,6 +984,8 @@ SdMmcPciHcDriverBindingStop (
     return Status;
   }
 
+  SdMmcFreeAdmaDescCache (Private);
+
   gBS->CloseProtocol (
          Controller,
          &gEfiPciIoProtocolGuid,
@@ -63,6 +63,12 @@ extern EDKII_SD_MMC_OVERRIDE  *mOverride;
 //
 #define SD_MMC_HC_ENUM_TIMER  EFI_TIMER_PERIOD_MILLISECONDS(100)
 
+//
+// Size of the ADMA descriptor table kept per slot and reused by the TRBs.
+// One page describes at least 16MB of data in any ADMA mode.
+//
+#define SD_MMC_HC_ADMA_DESC_CACHE_PAGES  1
+
 typedef enum {
   UnknownCardType,
   SdCardType,
@@ -121,6 +127,15 @@ typedef struct {
   // value stored in Capabilities Register 1.
   //
   UINT32                           BaseClkFreq[SD_MMC_HC_MAX_SLOT];
+
+  //
+  // ADMA descriptor table kept mapped per slot, so the TRBs don't have
+  // to allocate and map their own one.
+  //
+  VOID                             *AdmaDescCache[SD_MMC_HC_MAX_SLOT];
+  EFI_PHYSICAL_ADDRESS             AdmaDescCachePhy[SD_MMC_HC_MAX_SLOT];
+  VOID                             *AdmaDescCacheMap[SD_MMC_HC_MAX_SLOT];
+  BOOLEAN                          AdmaDescCacheBusy[SD_MMC_HC_MAX_SLOT];
 } SD_MMC_HC_PRIVATE_DATA;
 
 typedef struct {
@@ -168,6 +183,7 @@ typedef struct {
   EFI_PHYSICAL_ADDRESS                   AdmaDescPhy;
   VOID                                   *AdmaMap;
   UINT32                                 AdmaPages;
+  BOOLEAN                                AdmaDescCached;
 
   SD_MMC_HC_PRIVATE_DATA                 *Private;
 } SD_MMC_HC_TRB;
@@ -678,6 +694,17 @@ SdMmcCreateTrb (
   IN EFI_EVENT                            Event
   );
 
+/**
+  Free the ADMA descriptor tables cached for the slots of the host controller.
+
+  @param[in] Private        A pointer to the SD_MMC_HC_PRIVATE_DATA instance.
+
+**/
+VOID
+SdMmcFreeAdmaDescCache (
+  IN SD_MMC_HC_PRIVATE_DATA  *Private
+  );
+
 /**
   Free the resource used by the TRB.
 
@@ -1455,6 +1455,105 @@ SdMmcHcLedOnOff (
   return Status;
 }
 
+/**
+  Allocate and map a buffer for an ADMA descriptor table.
+
+  @param[in]  PciIo          The PCI IO protocol instance.
+  @param[in]  Pages          The number of pages of the table.
+  @param[out] AdmaDesc       The host address of the table.
+  @param[out] AdmaDescPhy    The device address of the table.
+  @param[out] AdmaMap        The mapping of the table.
+
+  @retval EFI_SUCCESS           The table is allocated and mapped.
+  @retval EFI_OUT_OF_RESOURCES  The table can't be allocated or mapped.
+
+**/
+STATIC
+EFI_STATUS
+SdMmcAllocateAdmaDesc (
+  IN  EFI_PCI_IO_PROTOCOL   *PciIo,
+  IN  UINTN                 Pages,
+  OUT VOID                  **AdmaDesc,
+  OUT EFI_PHYSICAL_ADDRESS  *AdmaDescPhy,
+  OUT VOID                  **AdmaMap
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Bytes;
+
+  Status = PciIo->AllocateBuffer (
+                    PciIo,
+                    AllocateAnyPages,
+                    EfiBootServicesData,
+                    Pages,
+                    AdmaDesc,
+                    0
+                    );
+  if (EFI_ERROR (Status)) {
+    *AdmaDesc = NULL;
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Bytes  = EFI_PAGES_TO_SIZE (Pages);
+  Status = PciIo->Map (
+                    PciIo,
+                    EfiPciIoOperationBusMasterCommonBuffer,
+                    *AdmaDesc,
+                    &Bytes,
+                    AdmaDescPhy,
+                    AdmaMap
+                    );
+
+  if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (Pages))) {
+    //
+    // Map error or unable to map the whole RFis buffer into a contiguous region.
+    //
+    PciIo->FreeBuffer (
+             PciIo,
+             Pages,
+             *AdmaDesc
+             );
+    *AdmaDesc = NULL;
+    *AdmaMap  = NULL;
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Free the ADMA descriptor tables cached for the slots of the host controller.
+
+  @param[in] Private        A pointer to the SD_MMC_HC_PRIVATE_DATA instance.
+
+**/
+VOID
+SdMmcFreeAdmaDescCache (
+  IN SD_MMC_HC_PRIVATE_DATA  *Private
+  )
+{
+  EFI_PCI_IO_PROTOCOL  *PciIo;
+  UINT8                Slot;
+
+  PciIo = Private->PciIo;
+  for (Slot = 0; Slot < SD_MMC_HC_MAX_SLOT; Slot++) {
+    if (Private->AdmaDescCache[Slot] == NULL) {
+      continue;
+    }
+
+    PciIo->Unmap (
+             PciIo,
+             Private->AdmaDescCacheMap[Slot]
+             );
+    PciIo->FreeBuffer (
+             PciIo,
+             SD_MMC_HC_ADMA_DESC_CACHE_PAGES,
+             Private->AdmaDescCache[Slot]
+             );
+    Private->AdmaDescCache[Slot] = NULL;
+  }
+}
+
 /**
   Build ADMA descriptor table for transfer.
 
@@ -1473,19 +1572,20 @@ BuildAdmaDescTable (
   IN UINT16         ControllerVer
   )
 {
-  EFI_PHYSICAL_ADDRESS  Data;
-  UINT64                DataLen;
-  UINT64                Entries;
-  UINT32                Index;
-  UINT64                Remaining;
-  UINT64                Address;
-  UINTN                 TableSize;
-  EFI_PCI_IO_PROTOCOL   *PciIo;
-  EFI_STATUS            Status;
-  UINTN                 Bytes;
-  UINT32                AdmaMaxDataPerLine;
-  UINT32                DescSize;
-  VOID                  *AdmaDesc;
+  EFI_PHYSICAL_ADDRESS    Data;
+  UINT64                  DataLen;
+  UINT64                  Entries;
+  UINT32                  Index;
+  UINT64                  Remaining;
+  UINT64                  Address;
+  UINTN                   TableSize;
+  EFI_PCI_IO_PROTOCOL     *PciIo;
+  EFI_STATUS              Status;
+  UINT32                  AdmaMaxDataPerLine;
+  UINT32                  DescSize;
+  VOID                    *AdmaDesc;
+  SD_MMC_HC_PRIVATE_DATA  *Private;
+  EFI_TPL                 OldTpl;
 
   AdmaMaxDataPerLine = ADMA_MAX_DATA_PER_LINE_16B;
   DescSize           = sizeof (SD_MMC_HC_ADMA_32_DESC_LINE);
@@ -1542,58 +1642,73 @@ BuildAdmaDescTable (
   Entries        = DivU64x32 ((DataLen + AdmaMaxDataPerLine - 1), AdmaMaxDataPerLine);
   TableSize      = (UINTN)MultU64x32 (Entries, DescSize);
   Trb->AdmaPages = (UINT32)EFI_SIZE_TO_PAGES (TableSize);
-  Status         = PciIo->AllocateBuffer (
-                            PciIo,
-                            AllocateAnyPages,
-                            EfiBootServicesData,
-                            EFI_SIZE_TO_PAGES (TableSize),
-                            (VOID **)&AdmaDesc,
-                            0
-                            );
-  if (EFI_ERROR (Status)) {
-    return EFI_OUT_OF_RESOURCES;
+
+  //
+  // Use the descriptor table cached for the slot when it is large enough
+  // and not held by another TRB. The claim is made at TPL_NOTIFY so that
+  // it cannot race with TRBs created by the async transfer timer.
+  //
+  Private = Trb->Private;
+  OldTpl  = gBS->RaiseTPL (TPL_NOTIFY);
+  if ((TableSize <= EFI_PAGES_TO_SIZE (SD_MMC_HC_ADMA_DESC_CACHE_PAGES)) &&
+      !Private->AdmaDescCacheBusy[Trb->Slot])
+  {
+    if (Private->AdmaDescCache[Trb->Slot] == NULL) {
+      SdMmcAllocateAdmaDesc (
+        PciIo,
+        SD_MMC_HC_ADMA_DESC_CACHE_PAGES,
+        &Private->AdmaDescCache[Trb->Slot],
+        &Private->AdmaDescCachePhy[Trb->Slot],
+        &Private->AdmaDescCacheMap[Trb->Slot]
+        );
+    }
+
+    if (Private->AdmaDescCache[Trb->Slot] != NULL) {
+      Private->AdmaDescCacheBusy[Trb->Slot] = TRUE;
+      Trb->AdmaDescCached                   = TRUE;
+      Trb->AdmaDescPhy                      = Private->AdmaDescCachePhy[Trb->Slot];
+      AdmaDesc                              = Private->AdmaDescCache[Trb->Slot];
+    }
   }
 
-  ZeroMem (AdmaDesc, TableSize);
-  Bytes  = TableSize;
-  Status = PciIo->Map (
-                    PciIo,
-                    EfiPciIoOperationBusMasterCommonBuffer,
-                    AdmaDesc,
-                    &Bytes,
-                    &Trb->AdmaDescPhy,
-                    &Trb->AdmaMap
-                    );
+  gBS->RestoreTPL (OldTpl);
 
-  if (EFI_ERROR (Status) || (Bytes != TableSize)) {
-    //
-    // Map error or unable to map the whole RFis buffer into a contiguous region.
-    //
-    PciIo->FreeBuffer (
-             PciIo,
-             EFI_SIZE_TO_PAGES (TableSize),
-             AdmaDesc
-             );
-    return EFI_OUT_OF_RESOURCES;
+  if (!Trb->AdmaDescCached) {
+    Status = SdMmcAllocateAdmaDesc (
+               PciIo,
+               Trb->AdmaPages,
+               &AdmaDesc,
+               &Trb->AdmaDescPhy,
+               &Trb->AdmaMap
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
+  ZeroMem (AdmaDesc, TableSize);
+
   if ((Trb->Mode == SdMmcAdma32bMode) &&
       ((UINT64)(UINTN)Trb->AdmaDescPhy > 0x100000000ul))
   {
     //
     // The ADMA doesn't support 64bit addressing.
+    // A cached table is released by SdMmcFreeTrb().
     //
-    PciIo->Unmap (
-             PciIo,
-             Trb->AdmaMap
-             );
-    Trb->AdmaMap = NULL;
+    if (!Trb->AdmaDescCached) {
+      PciIo->Unmap (
+               PciIo,
+               Trb->AdmaMap
+               );
+      Trb->AdmaMap = NULL;
+
+      PciIo->FreeBuffer (
+               PciIo,
+               Trb->AdmaPages,
+               AdmaDesc
+               );
+    }
 
-    PciIo->FreeBuffer (
-             PciIo,
-             EFI_SIZE_TO_PAGES (TableSize),
-             AdmaDesc
-             );
     return EFI_DEVICE_ERROR;
   }
 
@@ -1965,38 +2080,48 @@ SdMmcFreeTrb (
   )
 {
   EFI_PCI_IO_PROTOCOL  *PciIo;
+  EFI_TPL              OldTpl;
 
   PciIo = Trb->Private->PciIo;
 
-  if (Trb->AdmaMap != NULL) {
-    PciIo->Unmap (
-             PciIo,
-             Trb->AdmaMap
-             );
-  }
+  if (Trb->AdmaDescCached) {
+    //
+    // Hand the cached descriptor table back to the slot.
+    //
+    OldTpl                                     = gBS->RaiseTPL (TPL_NOTIFY);
+    Trb->Private->AdmaDescCacheBusy[Trb->Slot] = FALSE;
+    gBS->RestoreTPL (OldTpl);
+  } else {
+    if (Trb->AdmaMap != NULL) {
+      PciIo->Unmap (
+               PciIo,
+               Trb->AdmaMap
+               );
+    }
 
-  if (Trb->Adma32Desc != NULL) {
-    PciIo->FreeBuffer (
-             PciIo,
-             Trb->AdmaPages,
-             Trb->Adma32Desc
-             );
-  }
+    if (Trb->Adma32Desc != NULL) {
+      PciIo->FreeBuffer (
+               PciIo,
+               Trb->AdmaPages,
+               Trb->Adma32Desc
+               );
+    }
 
-  if (Trb->Adma64V3Desc != NULL) {
-    PciIo->FreeBuffer (
-             PciIo,
-             Trb->AdmaPages,
-             Trb->Adma64V3Desc
-             );
-  }
+    if (Trb->Adma64V3Desc != NULL) {
+      PciIo->FreeBuffer (
+               PciIo,
+               Trb->AdmaPages,
+               Trb->Adma64V3Desc
+               );
+    }
 
-  if (Trb->Adma64V4Desc != NULL) {
-    PciIo->FreeBuffer (
-             PciIo,
-             Trb->AdmaPages,
-             Trb->Adma64V4Desc
-             );
+    if (Trb->Adma64V4Desc != NULL) {
+      PciIo->FreeBuffer (
+               PciIo,
+               Trb->AdmaPages,
+               Trb->Adma64V4Desc
+               );
+    }
   }
 
   if (Trb->DataMap != NULL) {
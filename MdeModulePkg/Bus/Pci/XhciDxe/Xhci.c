@@ -1810,6 +1810,7 @@ XhcCreateUsbHc (
   UINT32             PageSize;
   UINT16             ExtCapReg;
   UINT8              ReleaseNumber;
+  UINTN              Index;
 
   Xhc = AllocateZeroPool (sizeof (USB_XHCI_INSTANCE));
 
@@ -1840,6 +1841,9 @@ XhcCreateUsbHc (
   }
 
   InitializeListHead (&Xhc->AsyncIntTransfers);
+  for (Index = 0; Index < XHC_ASYNC_INT_HASH_SIZE; Index++) {
+    InitializeListHead (&Xhc->AsyncIntHash[Index]);
+  }
 
   //
   // Be caution that the Offset passed to XhcReadCapReg() should be Dword align
@@ -74,6 +74,13 @@ typedef struct _USB_DEV_CONTEXT    USB_DEV_CONTEXT;
 //
 #define XHC_ASYNC_TIMER_INTERVAL  EFI_TIMER_PERIOD_MILLISECONDS(1)
 
+//
+// Async interrupt transfers are also hashed by their transfer ring so that
+// a transfer event can be matched to its URB without walking every one.
+//
+#define XHC_ASYNC_INT_HASH_SIZE   0x40
+#define XHC_ASYNC_INT_HASH(Ring)  ((((UINTN)(Ring)) >> 6) & (XHC_ASYNC_INT_HASH_SIZE - 1))
+
 //
 // XHC raises TPL to TPL_NOTIFY to serialize all its operations
 // to protect shared data structures.
@@ -218,6 +225,7 @@ struct _USB_XHCI_INSTANCE {
   EFI_EVENT                   ExitBootServiceEvent;
   EFI_EVENT                   PollTimer;
   LIST_ENTRY                  AsyncIntTransfers;
+  LIST_ENTRY                  AsyncIntHash[XHC_ASYNC_INT_HASH_SIZE];
 
   UINT8                       CapLength;  ///< Capability Register Length
   XHC_HCSPARAMS1              HcSParams1; ///< Structural Parameters 1
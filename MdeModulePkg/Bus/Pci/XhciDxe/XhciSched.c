@@ -394,25 +394,32 @@ XhcCreateTransferTrb (
 
     case ED_BULK_OUT:
     case ED_BULK_IN:
-      TotalLen = 0;
-      Len      = 0;
-      TrbNum   = 0;
-      TrbStart = (TRB *)(UINTN)EPRing->RingEnqueue;
+      //
+      // The whole buffer is described by a single TD of chained Normal TRBs,
+      // so the device sees one continuous transfer and a short packet ends it.
+      // A TRB buffer must not cross a 64KB boundary. Only the last TRB raises
+      // a completion event, so there is no separate event for the first TRB.
+      //
+      TotalLen       = 0;
+      Len            = 0;
+      TrbNum         = 0;
+      TrbStart       = (TRB *)(UINTN)EPRing->RingEnqueue;
+      Urb->StartDone = TRUE;
       while (TotalLen < Urb->DataLen) {
-        if ((TotalLen + 0x10000) >= Urb->DataLen) {
+        Len = 0x10000 - (((UINTN)Urb->DataPhy + TotalLen) & 0xFFFF);
+        if ((TotalLen + Len) >= Urb->DataLen) {
           Len = Urb->DataLen - TotalLen;
-        } else {
-          Len = 0x10000;
         }
 
         TrbStart                      = (TRB *)(UINTN)EPRing->RingEnqueue;
         TrbStart->TrbNormal.TRBPtrLo  = XHC_LOW_32BIT ((UINT8 *)Urb->DataPhy + TotalLen);
         TrbStart->TrbNormal.TRBPtrHi  = XHC_HIGH_32BIT ((UINT8 *)Urb->DataPhy + TotalLen);
         TrbStart->TrbNormal.Length    = (UINT32)Len;
-        TrbStart->TrbNormal.TDSize    = 0;
+        TrbStart->TrbNormal.TDSize    = (UINT32)MIN (31, (Urb->DataLen - TotalLen - Len + Urb->Ep.MaxPacket - 1) / Urb->Ep.MaxPacket);
         TrbStart->TrbNormal.IntTarget = 0;
         TrbStart->TrbNormal.ISP       = 1;
-        TrbStart->TrbNormal.IOC       = 1;
+        TrbStart->TrbNormal.CH        = ((TotalLen + Len) < Urb->DataLen) ? 1 : 0;
+        TrbStart->TrbNormal.IOC       = ((TotalLen + Len) < Urb->DataLen) ? 0 : 1;
         TrbStart->TrbNormal.Type      = TRB_TYPE_NORMAL;
         //
         // Update the cycle bit
@@ -1065,7 +1072,11 @@ IsTransferRingTrb (
 /**
   Check if the Trb is a transaction of the URBs in XHCI's asynchronous transfer list.
 
+  The transfer event names the slot and endpoint it belongs to, so only the
+  URBs hashed under that endpoint's transfer ring need to be checked.
+
   @param Xhc    The XHCI Instance.
+  @param EvtTrb The transfer event reporting the Trb.
   @param Trb    The TRB to be checked.
   @param Urb    The pointer to the matched Urb.
 
@@ -1076,17 +1087,29 @@ IsTransferRingTrb (
 BOOLEAN
 IsAsyncIntTrb (
   IN  USB_XHCI_INSTANCE  *Xhc,
+  IN  EVT_TRB_TRANSFER   *EvtTrb,
   IN  TRB_TEMPLATE       *Trb,
   OUT URB                **Urb
   )
 {
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
-  URB         *CheckedUrb;
+  LIST_ENTRY     *Entry;
+  LIST_ENTRY     *Head;
+  URB            *CheckedUrb;
+  TRANSFER_RING  *Ring;
 
-  BASE_LIST_FOR_EACH_SAFE (Entry, Next, &Xhc->AsyncIntTransfers) {
-    CheckedUrb = EFI_LIST_CONTAINER (Entry, URB, UrbList);
-    if (IsTransferRingTrb (Xhc, Trb, CheckedUrb)) {
+  if ((EvtTrb->Type != TRB_TYPE_TRANS_EVENT) || (EvtTrb->EndpointId == 0)) {
+    return FALSE;
+  }
+
+  Ring = (TRANSFER_RING *)(UINTN)Xhc->UsbDevContext[EvtTrb->SlotId].EndpointTransferRing[EvtTrb->EndpointId - 1];
+  if (Ring == NULL) {
+    return FALSE;
+  }
+
+  Head = &Xhc->AsyncIntHash[XHC_ASYNC_INT_HASH (Ring)];
+  BASE_LIST_FOR_EACH (Entry, Head) {
+    CheckedUrb = EFI_LIST_CONTAINER (Entry, URB, HashLink);
+    if ((CheckedUrb->Ring == Ring) && IsTransferRingTrb (Xhc, Trb, CheckedUrb)) {
       *Urb = CheckedUrb;
       return TRUE;
     }
@@ -1099,8 +1122,12 @@ IsAsyncIntTrb (
   Check the URB's execution result and update the URB's
   result accordingly.
 
+  Every new event on the event ring is consumed, and the pending URB and the
+  async interrupt URBs it belongs to are updated as well. Urb may be NULL to
+  only dispatch the new events.
+
   @param  Xhc             The XHCI Instance.
-  @param  Urb             The URB to check result.
+  @param  Urb             The URB to check result, or NULL.
 
   @return Whether the result of URB transfer is finialized.
 
@@ -1108,7 +1135,7 @@ IsAsyncIntTrb (
 BOOLEAN
 XhcCheckUrbResult (
   IN  USB_XHCI_INSTANCE  *Xhc,
-  IN  URB                *Urb
+  IN  URB                *Urb  OPTIONAL
   )
 {
   EVT_TRB_TRANSFER      *EvtTrb;
@@ -1122,20 +1149,27 @@ XhcCheckUrbResult (
   UINT32                High;
   UINT32                Low;
   EFI_PHYSICAL_ADDRESS  PhyAddr;
+  TRANSFER_TRB_NORMAL   *TrbNormal;
+  EFI_PHYSICAL_ADDRESS  TrbData;
+  BOOLEAN               Consumed;
 
-  ASSERT ((Xhc != NULL) && (Urb != NULL));
+  ASSERT (Xhc != NULL);
 
   Status   = EFI_SUCCESS;
   AsyncUrb = NULL;
+  Consumed = FALSE;
 
-  if (Urb->Finished) {
+  if ((Urb != NULL) && Urb->Finished) {
     goto EXIT;
   }
 
   EvtTrb = NULL;
 
   if (XhcIsHalt (Xhc) || XhcIsSysError (Xhc)) {
-    Urb->Result |= EFI_USB_ERR_SYSTEM;
+    if (Urb != NULL) {
+      Urb->Result |= EFI_USB_ERR_SYSTEM;
+    }
+
     goto EXIT;
   }
 
@@ -1152,6 +1186,8 @@ XhcCheckUrbResult (
       goto EXIT;
     }
 
+    Consumed = TRUE;
+
     //
     // Only handle COMMAND_COMPLETETION_EVENT and TRANSFER_EVENT.
     //
@@ -1173,9 +1209,9 @@ XhcCheckUrbResult (
     //
     if ((Xhc->PendingUrb != NULL) && IsTransferRingTrb (Xhc, TRBPtr, Xhc->PendingUrb)) {
       CheckedUrb = Xhc->PendingUrb;
-    } else if (IsTransferRingTrb (Xhc, TRBPtr, Urb)) {
+    } else if ((Urb != NULL) && IsTransferRingTrb (Xhc, TRBPtr, Urb)) {
       CheckedUrb = Urb;
-    } else if (IsAsyncIntTrb (Xhc, TRBPtr, &AsyncUrb)) {
+    } else if (IsAsyncIntTrb (Xhc, EvtTrb, TRBPtr, &AsyncUrb)) {
       CheckedUrb = AsyncUrb;
     } else {
       continue;
@@ -1221,14 +1257,33 @@ XhcCheckUrbResult (
 
       case TRB_COMPLETION_SHORT_PACKET:
       case TRB_COMPLETION_SUCCESS:
+        if (CheckedUrb->Finished) {
+          //
+          // A bulk TD that ended early on a short packet may still report
+          // its last TRB. The data length was already accounted for.
+          //
+          continue;
+        }
+
         if (EvtTrb->Completecode == TRB_COMPLETION_SHORT_PACKET) {
           DEBUG ((DEBUG_VERBOSE, "XhcCheckUrbResult: short packet happens!\n"));
+          if (CheckedUrb->Ep.Type == XHC_BULK_TRANSFER) {
+            CheckedUrb->EndDone = TRUE;
+          }
         }
 
         TRBType = (UINT8)(TRBPtr->Type);
-        if ((TRBType == TRB_TYPE_DATA_STAGE) ||
-            (TRBType == TRB_TYPE_NORMAL) ||
-            (TRBType == TRB_TYPE_ISOCH))
+        if ((TRBType == TRB_TYPE_NORMAL) && (CheckedUrb->Ep.Type == XHC_BULK_TRANSFER)) {
+          //
+          // Only the TRB that ends a chained bulk TD reports, and every TRB
+          // before it in the TD was transferred in full.
+          //
+          TrbNormal             = (TRANSFER_TRB_NORMAL *)TRBPtr;
+          TrbData               = (EFI_PHYSICAL_ADDRESS)(TrbNormal->TRBPtrLo | LShiftU64 ((UINT64)TrbNormal->TRBPtrHi, 32));
+          CheckedUrb->Completed = (UINTN)(TrbData - (UINTN)CheckedUrb->DataPhy) + TrbNormal->Length - EvtTrb->Length;
+        } else if ((TRBType == TRB_TYPE_DATA_STAGE) ||
+                   (TRBType == TRB_TYPE_NORMAL) ||
+                   (TRBType == TRB_TYPE_ISOCH))
         {
           CheckedUrb->Completed += (((TRANSFER_TRB_NORMAL *)TRBPtr)->Length - EvtTrb->Length);
         }
@@ -1261,6 +1316,14 @@ XhcCheckUrbResult (
 
 EXIT:
 
+  //
+  // Nothing was consumed from the event ring, so the dequeue pointer the
+  // controller holds is already current.
+  //
+  if (!Consumed) {
+    return (Urb != NULL) ? Urb->Finished : FALSE;
+  }
+
   //
   // Advance event ring to last available entry
   //
@@ -1282,7 +1345,7 @@ EXIT:
     XhcWriteRuntimeReg (Xhc, XHC_ERDP_OFFSET + 4, XHC_HIGH_32BIT (PhyAddr));
   }
 
-  return Urb->Finished;
+  return (Urb != NULL) ? Urb->Finished : FALSE;
 }
 
 /**
@@ -1420,6 +1483,7 @@ XhciDelAsyncIntTransfer (
       }
 
       RemoveEntryList (&Urb->UrbList);
+      RemoveEntryList (&Urb->HashLink);
       //
       // For `XhciDelAsyncIntTransfer`, the URB is created through `XhciInsertAsyncIntTransfer`
       // and allocates and manages its own data buffer, so free it here.
@@ -1467,6 +1531,7 @@ XhciDelAllAsyncIntTransfers (
     }
 
     RemoveEntryList (&Urb->UrbList);
+    RemoveEntryList (&Urb->HashLink);
     //
     // For `XhciDelAllAsyncIntTransfers`, the URB is created through `XhciInsertAsyncIntTransfer`
     // and allocates and manages its own data buffer, so free it here.
@@ -1540,6 +1605,7 @@ XhciInsertAsyncIntTransfer (
   // Check the comments in XhcMoniteAsyncRequests
   //
   InsertHeadList (&Xhc->AsyncIntTransfers, &Urb->UrbList);
+  InsertTailList (&Xhc->AsyncIntHash[XHC_ASYNC_INT_HASH (Urb->Ring)], &Urb->HashLink);
 
   return Urb;
 }
@@ -1565,6 +1631,13 @@ XhcUpdateAsyncRequest (
       return;
     }
 
+    //
+    // The endpoint may have been given a new transfer ring since the URB
+    // was hashed.
+    //
+    RemoveEntryList (&Urb->HashLink);
+    InsertTailList (&Xhc->AsyncIntHash[XHC_ASYNC_INT_HASH (Urb->Ring)], &Urb->HashLink);
+
     Status = RingIntTransferDoorBell (Xhc, Urb);
     if (EFI_ERROR (Status)) {
       return;
@@ -1654,6 +1727,14 @@ XhcMonitorAsyncRequests (
 
   Xhc = (USB_XHCI_INSTANCE *)Context;
 
+  //
+  // Drain the event ring once for this tick. Every transfer event is matched
+  // to its URB and updates it, so the URBs only need their state checked.
+  //
+  if (!IsListEmpty (&Xhc->AsyncIntTransfers)) {
+    XhcCheckUrbResult (Xhc, NULL);
+  }
+
   BASE_LIST_FOR_EACH_SAFE (Entry, Next, &Xhc->AsyncIntTransfers) {
     //
     // Save values passed into the callback.
@@ -1677,11 +1758,8 @@ XhcMonitorAsyncRequests (
     }
 
     //
-    // Check the result of URB execution. If it is still
-    // active, check the next one.
+    // If the URB is still active, check the next one.
     //
-    XhcCheckUrbResult (Xhc, Urb);
-
     if (!Urb->Finished) {
       continue;
     }
@@ -2038,6 +2116,12 @@ XhcSyncTrsRing (
     if ((UINT8)TrsTrb->Type == TRB_TYPE_LINK) {
       ASSERT (((LINK_TRB *)TrsTrb)->TC != 0);
       //
+      // A Link TRB inside a TD must have its chain bit set, so let it follow
+      // the TRB in front of it. That bit is RsvdZ in TRBs that cannot chain.
+      // It is updated before the cycle bit hands the Link TRB to the xHC.
+      //
+      ((LINK_TRB *)TrsTrb)->CH = ((TRANSFER_TRB_NORMAL *)(TrsTrb - 1))->CH;
+      //
       // set cycle bit in Link TRB as normal
       //
       ((LINK_TRB *)TrsTrb)->CycleBit = TrsRing->RingPCS & BIT0;
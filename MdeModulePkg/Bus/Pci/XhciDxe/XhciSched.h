@@ -170,6 +170,10 @@ typedef struct _URB {
   UINT32                             Signature;
   LIST_ENTRY                         UrbList;
   //
+  // Link in the XHCI's async interrupt transfer hash, keyed by Ring.
+  //
+  LIST_ENTRY                         HashLink;
+  //
   // Usb Device URB related information
   //
   USB_ENDPOINT                       Ep;
@@ -2745,6 +2745,12 @@ ScsiDiskInquiryDevice (
               (BlockLimits->OptimalTransferLengthGranularity2 << 8) |
               BlockLimits->OptimalTransferLengthGranularity1;
 
+            ScsiDiskDevice->MaxTransferBlocks =
+              (BlockLimits->MaximumTransferLength4 << 24) |
+              (BlockLimits->MaximumTransferLength3 << 16) |
+              (BlockLimits->MaximumTransferLength2 << 8)  |
+              BlockLimits->MaximumTransferLength1;
+
             ScsiDiskDevice->UnmapInfo.MaxLbaCnt =
               (BlockLimits->MaximumUnmapLbaCount4 << 24) |
               (BlockLimits->MaximumUnmapLbaCount3 << 16) |
@@ -3557,8 +3563,22 @@ ScsiDiskReadSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
+  //
+  // A transfer that spans several commands keeps them outstanding together
+  //
+  if (NumberOfBlocks > MaxBlock) {
+    Status = ScsiDiskPipelinedReadWriteSectors (ScsiDiskDevice, TRUE, Buffer, Lba, NumberOfBlocks);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+  }
+
   while (BlocksRemaining > 0) {
     if (BlocksRemaining <= MaxBlock) {
       if (!ScsiDiskDevice->Cdb16Byte) {
@@ -3651,6 +3671,13 @@ ScsiDiskReadSectors (
       NextSectorCount = ByteCount / BlockSize;
       if (NextSectorCount < SectorCount) {
         SectorCount = NextSectorCount;
+        if (SectorCount != 0) {
+          //
+          // Split later transfers at this length up front
+          //
+          ScsiDiskDevice->MaxTransferBlocks = SectorCount;
+        }
+
         //
         // Account for any rounding down.
         //
@@ -3722,8 +3749,22 @@ ScsiDiskWriteSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
+  //
+  // A transfer that spans several commands keeps them outstanding together
+  //
+  if (NumberOfBlocks > MaxBlock) {
+    Status = ScsiDiskPipelinedReadWriteSectors (ScsiDiskDevice, FALSE, Buffer, Lba, NumberOfBlocks);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+  }
+
   while (BlocksRemaining > 0) {
     if (BlocksRemaining <= MaxBlock) {
       if (!ScsiDiskDevice->Cdb16Byte) {
@@ -3815,6 +3856,13 @@ ScsiDiskWriteSectors (
       NextSectorCount = ByteCount / BlockSize;
       if (NextSectorCount < SectorCount) {
         SectorCount = NextSectorCount;
+        if (SectorCount != 0) {
+          //
+          // Split later transfers at this length up front
+          //
+          ScsiDiskDevice->MaxTransferBlocks = SectorCount;
+        }
+
         //
         // Account for any rounding down.
         //
@@ -3839,6 +3887,124 @@ ScsiDiskWriteSectors (
   return EFI_SUCCESS;
 }
 
+/**
+  Read or write sectors of SCSI Disk for a blocking request, keeping up to
+  SCSI_DISK_PIPELINE_DEPTH commands of MaxTransferBlocks blocks outstanding.
+
+  Each command is sent as a BlockIo2 request of its own, through the same
+  non-blocking path as ReadBlocksEx()/WriteBlocksEx(), including its retries.
+  On host adapters without non-blocking I/O support the commands simply run
+  one after another.
+
+  @param  ScsiDiskDevice  The pointer of SCSI_DISK_DEV.
+  @param  Read            TRUE to read, FALSE to write.
+  @param  Buffer          The buffer of the data.
+  @param  Lba             Logic block address.
+  @param  NumberOfBlocks  The number of blocks to transfer.
+
+  @retval EFI_SUCCESS       Operation is successful.
+  @retval EFI_UNSUPPORTED   The transfer could not be started; nothing was sent
+                            to the device.
+  @retval EFI_DEVICE_ERROR  Indicates a device error.
+
+**/
+EFI_STATUS
+ScsiDiskPipelinedReadWriteSectors (
+  IN     SCSI_DISK_DEV  *ScsiDiskDevice,
+  IN     BOOLEAN        Read,
+  IN OUT UINT8          *Buffer,
+  IN     EFI_LBA        Lba,
+  IN     UINTN          NumberOfBlocks
+  )
+{
+  EFI_STATUS           Status;
+  EFI_BLOCK_IO2_TOKEN  Tokens[SCSI_DISK_PIPELINE_DEPTH];
+  BOOLEAN              Busy[SCSI_DISK_PIPELINE_DEPTH];
+  UINTN                Slot;
+  UINTN                ChunkBlocks;
+  UINTN                SectorCount;
+  UINT32               BlockSize;
+  BOOLEAN              Started;
+
+  BlockSize   = ScsiDiskDevice->BlkIo.Media->BlockSize;
+  ChunkBlocks = ScsiDiskDevice->Cdb16Byte ? 0xFFFFFFFF : 0xFFFF;
+  if (ScsiDiskDevice->MaxTransferBlocks != 0) {
+    ChunkBlocks = MIN (ChunkBlocks, ScsiDiskDevice->MaxTransferBlocks);
+  }
+
+  ZeroMem (Busy, sizeof (Busy));
+  for (Slot = 0; Slot < SCSI_DISK_PIPELINE_DEPTH; Slot++) {
+    Status = gBS->CreateEvent (0, TPL_NOTIFY, NULL, NULL, &Tokens[Slot].Event);
+    if (EFI_ERROR (Status)) {
+      while (Slot > 0) {
+        gBS->CloseEvent (Tokens[--Slot].Event);
+      }
+
+      return EFI_UNSUPPORTED;
+    }
+  }
+
+  Status  = EFI_SUCCESS;
+  Started = FALSE;
+  Slot    = 0;
+  while (NumberOfBlocks > 0) {
+    //
+    // Reuse the oldest slot once its command completes
+    //
+    if (Busy[Slot]) {
+      while (gBS->CheckEvent (Tokens[Slot].Event) == EFI_NOT_READY) {
+      }
+
+      Busy[Slot] = FALSE;
+      if (EFI_ERROR (Tokens[Slot].TransactionStatus)) {
+        Status = EFI_DEVICE_ERROR;
+        break;
+      }
+    }
+
+    SectorCount                    = MIN (NumberOfBlocks, ChunkBlocks);
+    Tokens[Slot].TransactionStatus = EFI_SUCCESS;
+    if (Read) {
+      Status = ScsiDiskAsyncReadSectors (ScsiDiskDevice, Buffer, Lba, SectorCount, &Tokens[Slot]);
+    } else {
+      Status = ScsiDiskAsyncWriteSectors (ScsiDiskDevice, Buffer, Lba, SectorCount, &Tokens[Slot]);
+    }
+
+    if (EFI_ERROR (Status)) {
+      //
+      // Nothing of this request is outstanding
+      //
+      Status = Started ? EFI_DEVICE_ERROR : EFI_UNSUPPORTED;
+      break;
+    }
+
+    Busy[Slot]      = TRUE;
+    Started         = TRUE;
+    Lba            += SectorCount;
+    Buffer         += SectorCount * BlockSize;
+    NumberOfBlocks -= SectorCount;
+    Slot            = (Slot + 1) % SCSI_DISK_PIPELINE_DEPTH;
+  }
+
+  //
+  // Drain the commands still outstanding before releasing the tokens
+  //
+  for (Slot = 0; Slot < SCSI_DISK_PIPELINE_DEPTH; Slot++) {
+    if (Busy[Slot]) {
+      while (gBS->CheckEvent (Tokens[Slot].Event) == EFI_NOT_READY) {
+      }
+
+      if (EFI_ERROR (Tokens[Slot].TransactionStatus)) {
+        Status = EFI_DEVICE_ERROR;
+      }
+    }
+
+    gBS->CloseEvent (Tokens[Slot].Event);
+  }
+
+  return Status;
+}
+
 /**
   Asynchronously read sector from SCSI Disk.
 
@@ -3906,6 +4072,10 @@ ScsiDiskAsyncReadSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
   while (BlocksRemaining > 0) {
@@ -4124,6 +4294,10 @@ ScsiDiskAsyncWriteSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
   while (BlocksRemaining > 0) {
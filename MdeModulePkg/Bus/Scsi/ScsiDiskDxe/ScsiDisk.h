@@ -90,6 +90,12 @@ typedef struct {
   //
   BOOLEAN                                  Cdb16Byte;
 
+  //
+  // The maximum number of blocks one Read/Write command can transfer, from the
+  // Block Limits VPD page or as lowered by the host adapter. 0 if not known.
+  //
+  UINT32                                   MaxTransferBlocks;
+
   //
   // The queue for asynchronous task requests
   //
@@ -195,6 +201,12 @@ extern EFI_COMPONENT_NAME2_PROTOCOL  gScsiDiskComponentName2;
 //
 #define SCSI_DISK_TIMEOUT  EFI_TIMER_PERIOD_SECONDS (30)
 
+//
+// Number of Read/Write commands kept outstanding by a blocking transfer that
+// spans several commands
+//
+#define SCSI_DISK_PIPELINE_DEPTH  8
+
 /**
   Test to see if this driver supports ControllerHandle.
 
@@ -1094,6 +1106,31 @@ ScsiDiskWriteSectors (
   IN  UINTN          NumberOfBlocks
   );
 
+/**
+  Read or write sectors of SCSI Disk for a blocking request, keeping up to
+  SCSI_DISK_PIPELINE_DEPTH commands of MaxTransferBlocks blocks outstanding.
+
+  @param  ScsiDiskDevice  The pointer of SCSI_DISK_DEV.
+  @param  Read            TRUE to read, FALSE to write.
+  @param  Buffer          The buffer of the data.
+  @param  Lba             Logic block address.
+  @param  NumberOfBlocks  The number of blocks to transfer.
+
+  @retval EFI_SUCCESS       Operation is successful.
+  @retval EFI_UNSUPPORTED   The transfer could not be started; nothing was sent
+                            to the device.
+  @retval EFI_DEVICE_ERROR  Indicates a device error.
+
+**/
+EFI_STATUS
+ScsiDiskPipelinedReadWriteSectors (
+  IN     SCSI_DISK_DEV  *ScsiDiskDevice,
+  IN     BOOLEAN        Read,
+  IN OUT UINT8          *Buffer,
+  IN     EFI_LBA        Lba,
+  IN     UINTN          NumberOfBlocks
+  );
+
 /**
   Asynchronously read sector from SCSI Disk.
 
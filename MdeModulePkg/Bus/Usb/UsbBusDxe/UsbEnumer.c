@@ -652,6 +652,7 @@ UsbFindChild (
   @param  HubIf                 The HUB that has the device connected.
   @param  Port                  The port index of the hub (started with zero).
   @param  ResetIsNeeded         The boolean to control whether skip the reset of the port.
+  @param  PortStable            The caller already waited for the port to be stable.
 
   @retval EFI_SUCCESS           The device is enumerated (added or removed).
   @retval EFI_OUT_OF_RESOURCES  Failed to allocate resource for the device.
@@ -662,7 +663,8 @@ EFI_STATUS
 UsbEnumerateNewDev (
   IN USB_INTERFACE  *HubIf,
   IN UINT8          Port,
-  IN BOOLEAN        ResetIsNeeded
+  IN BOOLEAN        ResetIsNeeded,
+  IN BOOLEAN        PortStable
   )
 {
   USB_BUS              *Bus;
@@ -679,7 +681,9 @@ UsbEnumerateNewDev (
   HubApi  = HubIf->HubApi;
   Address = Bus->MaxDevices;
 
-  gBS->Stall (USB_WAIT_PORT_STABLE_STALL);
+  if (!PortStable) {
+    gBS->Stall (USB_WAIT_PORT_STABLE_STALL);
+  }
 
   //
   // Hub resets the device for at least 10 milliseconds.
@@ -880,6 +884,7 @@ ON_ERROR:
 
   @param  HubIf                 The HUB that has the device connected.
   @param  Port                  The port index of the hub (started with zero).
+  @param  Change                The state of the port read by UsbGetPortChange().
 
   @retval EFI_SUCCESS           The device is enumerated (added or removed).
   @retval EFI_OUT_OF_RESOURCES  Failed to allocate resource for the device.
@@ -888,8 +893,9 @@ ON_ERROR:
 **/
 EFI_STATUS
 UsbEnumeratePort (
-  IN USB_INTERFACE  *HubIf,
-  IN UINT8          Port
+  IN USB_INTERFACE    *HubIf,
+  IN UINT8            Port,
+  IN USB_PORT_CHANGE  *Change
   )
 {
   USB_HUB_API          *HubApi;
@@ -897,18 +903,10 @@ UsbEnumeratePort (
   EFI_USB_PORT_STATUS  PortState;
   EFI_STATUS           Status;
 
-  Child  = NULL;
-  HubApi = HubIf->HubApi;
-
-  // Zero out PortState in case GetPortStatus does not set
-  // it and we continue on the EFI_DEVICE_ERROR path
-  PortState.PortStatus       = 0;
-  PortState.PortChangeStatus = 0;
-
-  //
-  // Host learns of the new device by polling the hub for port changes.
-  //
-  Status = HubApi->GetPortStatus (HubIf, Port, &PortState);
+  Child     = NULL;
+  HubApi    = HubIf->HubApi;
+  PortState = Change->PortState;
+  Status    = Change->Status;
 
   if (EFI_ERROR (Status) && (Status != EFI_DEVICE_ERROR)) {
     DEBUG ((DEBUG_ERROR, "UsbEnumeratePort: failed to get state of port %d\n", Port));
@@ -992,13 +990,16 @@ UsbEnumeratePort (
     // Now, new device connected, enumerate and configure the device
     //
     DEBUG ((DEBUG_INFO, "UsbEnumeratePort: new device connected at port %d\n", Port));
+    PERF_INMODULE_BEGIN ("UsbEnumerateNewDev");
     if (USB_BIT_IS_SET (PortState.PortChangeStatus, USB_PORT_STAT_C_RESET) &&
         (Status != EFI_DEVICE_ERROR))
     {
-      Status = UsbEnumerateNewDev (HubIf, Port, FALSE);
+      Status = UsbEnumerateNewDev (HubIf, Port, FALSE, Change->Stable);
     } else {
-      Status = UsbEnumerateNewDev (HubIf, Port, TRUE);
+      Status = UsbEnumerateNewDev (HubIf, Port, TRUE, Change->Stable);
     }
+
+    PERF_INMODULE_END ("UsbEnumerateNewDev");
   } else {
     DEBUG ((DEBUG_INFO, "UsbEnumeratePort: device disconnected event on port %d\n", Port));
   }
@@ -1007,6 +1008,113 @@ UsbEnumeratePort (
   return Status;
 }
 
+/**
+  Read the state of a hub port before it is enumerated.
+
+  @param  HubIf                 The hub interface.
+  @param  Port                  The port index of the hub (started with zero).
+  @param  Change                Returns the state of the port.
+
+**/
+VOID
+UsbGetPortChange (
+  IN  USB_INTERFACE    *HubIf,
+  IN  UINT8            Port,
+  OUT USB_PORT_CHANGE  *Change
+  )
+{
+  //
+  // Zero out PortState in case GetPortStatus does not set
+  // it and we continue on the EFI_DEVICE_ERROR path
+  //
+  Change->Pending                    = TRUE;
+  Change->Stable                     = FALSE;
+  Change->PortState.PortStatus       = 0;
+  Change->PortState.PortChangeStatus = 0;
+
+  //
+  // Host learns of the new device by polling the hub for port changes.
+  //
+  Change->Status = HubIf->HubApi->GetPortStatus (HubIf, Port, &Change->PortState);
+}
+
+/**
+  Enumerate the changed ports of a hub.
+
+  The state of every port is read first. A newly connected device needs
+  100ms to become stable before its port is reset, and waiting once for
+  all of the ports that report a new connection lets those intervals
+  overlap instead of adding up.
+
+  @param  HubIf                 The hub interface.
+  @param  ChangeMap             Optional. The hub's port change bitmap. All
+                                ports are enumerated when it is NULL.
+
+**/
+VOID
+UsbEnumeratePorts (
+  IN USB_INTERFACE  *HubIf,
+  IN UINT8          *ChangeMap  OPTIONAL
+  )
+{
+  USB_PORT_CHANGE  *Changes;
+  USB_PORT_CHANGE  Change;
+  BOOLEAN          Wait;
+  UINT8            Index;
+  UINT8            Byte;
+  UINT8            Bit;
+
+  Changes = AllocateZeroPool (HubIf->NumOfPort * sizeof (USB_PORT_CHANGE));
+  Wait    = FALSE;
+
+  //
+  // HUB starts its port index with 1.
+  //
+  Byte = 0;
+  Bit  = 1;
+
+  for (Index = 0; Index < HubIf->NumOfPort; Index++) {
+    if ((ChangeMap == NULL) || USB_BIT_IS_SET (ChangeMap[Byte], USB_BIT (Bit))) {
+      if (Changes == NULL) {
+        //
+        // Without room to hold the port states, handle the ports one by one.
+        //
+        UsbGetPortChange (HubIf, Index, &Change);
+        UsbEnumeratePort (HubIf, Index, &Change);
+      } else {
+        UsbGetPortChange (HubIf, Index, &Changes[Index]);
+        if (!EFI_ERROR (Changes[Index].Status) &&
+            USB_BIT_IS_SET (Changes[Index].PortState.PortChangeStatus, USB_PORT_STAT_C_CONNECTION) &&
+            USB_BIT_IS_SET (Changes[Index].PortState.PortStatus, USB_PORT_STAT_CONNECTION))
+        {
+          Changes[Index].Stable = TRUE;
+          Wait                  = TRUE;
+        }
+      }
+    }
+
+    USB_NEXT_BIT (Byte, Bit);
+  }
+
+  if (Changes == NULL) {
+    return;
+  }
+
+  if (Wait) {
+    PERF_INMODULE_BEGIN ("UsbWaitPortStable");
+    gBS->Stall (USB_WAIT_PORT_STABLE_STALL);
+    PERF_INMODULE_END ("UsbWaitPortStable");
+  }
+
+  for (Index = 0; Index < HubIf->NumOfPort; Index++) {
+    if (Changes[Index].Pending) {
+      UsbEnumeratePort (HubIf, Index, &Changes[Index]);
+    }
+  }
+
+  FreePool (Changes);
+}
+
 /**
   Enumerate all the changed hub ports.
 
@@ -1022,8 +1130,6 @@ UsbHubEnumeration (
   )
 {
   USB_INTERFACE  *HubIf;
-  UINT8          Byte;
-  UINT8          Bit;
   UINT8          Index;
   USB_DEVICE     *Child;
 
@@ -1043,19 +1149,7 @@ UsbHubEnumeration (
     return;
   }
 
-  //
-  // HUB starts its port index with 1.
-  //
-  Byte = 0;
-  Bit  = 1;
-
-  for (Index = 0; Index < HubIf->NumOfPort; Index++) {
-    if (USB_BIT_IS_SET (HubIf->ChangeMap[Byte], USB_BIT (Bit))) {
-      UsbEnumeratePort (HubIf, Index);
-    }
-
-    USB_NEXT_BIT (Byte, Bit);
-  }
+  UsbEnumeratePorts (HubIf, HubIf->ChangeMap);
 
   UsbHubAckHubStatus (HubIf->Device);
 
@@ -1090,7 +1184,7 @@ UsbRootHubEnumeration (
       DEBUG ((DEBUG_INFO, "UsbEnumeratePort: The device disconnect fails at port %d from root hub %p, try again\n", Index, RootHub));
       UsbRemoveDevice (Child);
     }
-
-    UsbEnumeratePort (RootHub, Index);
   }
+
+  UsbEnumeratePorts (RootHub, NULL);
 }
@@ -22,6 +22,16 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
             }                 \
           } while (0)
 
+//
+// State of one hub port, read before the ports of the hub are enumerated.
+//
+typedef struct {
+  BOOLEAN                Pending;   ///< The port is to be enumerated
+  BOOLEAN                Stable;    ///< The connect debounce wait is already done
+  EFI_STATUS             Status;    ///< Result of reading the port status
+  EFI_USB_PORT_STATUS    PortState;
+} USB_PORT_CHANGE;
+
 //
 // Common interface used by usb bus enumeration process.
 // This interface is defined to mask the difference between
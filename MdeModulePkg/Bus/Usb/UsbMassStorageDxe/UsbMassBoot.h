@@ -59,9 +59,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define USB_PDT_SIMPLE_DIRECT  0x0E                ///< Simplified direct access device
 
 //
-// Other parameters, Max carried size is 64KB.
+// Other parameters, Max carried size is 64KB. SuperSpeed devices move a
+// command's data as one chained transfer, so they carry up to 1MB per
+// command to save the CBW/CSW round trips.
 //
-#define USB_BOOT_MAX_CARRY_SIZE  SIZE_64KB
+#define USB_BOOT_MAX_CARRY_SIZE              SIZE_64KB
+#define USB_BOOT_MAX_CARRY_SIZE_SUPER_SPEED  SIZE_1MB
 
 //
 // Retry mass command times, set by experience
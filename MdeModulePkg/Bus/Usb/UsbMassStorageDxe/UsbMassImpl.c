@@ -337,11 +337,21 @@ UsbMassInitMedia (
   IN USB_MASS_DEVICE  *UsbMass
   )
 {
-  EFI_BLOCK_IO_MEDIA  *Media;
-  EFI_STATUS          Status;
+  EFI_BLOCK_IO_MEDIA         *Media;
+  EFI_STATUS                 Status;
+  EFI_USB_DEVICE_DESCRIPTOR  DevDesc;
 
   Media = &UsbMass->BlockIoMedia;
 
+  //
+  // A device only reports USB 3.x in bcdUSB while it runs at SuperSpeed.
+  //
+  UsbMass->MaxCarrySize = USB_BOOT_MAX_CARRY_SIZE;
+  Status                = UsbMass->UsbIo->UsbGetDeviceDescriptor (UsbMass->UsbIo, &DevDesc);
+  if (!EFI_ERROR (Status) && (DevDesc.BcdUSB >= 0x0300)) {
+    UsbMass->MaxCarrySize = USB_BOOT_MAX_CARRY_SIZE_SUPER_SPEED;
+  }
+
   //
   // Fields of EFI_BLOCK_IO_MEDIA are defined in UEFI 2.0 spec,
   // section for Block I/O Protocol.
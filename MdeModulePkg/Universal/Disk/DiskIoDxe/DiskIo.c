@@ -28,6 +28,11 @@ EFI_DRIVER_BINDING_PROTOCOL  gDiskIoDriverBinding = {
   NULL
 };
 
+//
+// Enabled caches of all the instances, checked when any instance writes.
+//
+LIST_ENTRY  mDiskIoCacheList = INITIALIZE_LIST_HEAD_VARIABLE (mDiskIoCacheList);
+
 //
 // Template for DiskIo private data structure.
 // The pointer to BlockIo protocol interface is assigned dynamically.
@@ -186,6 +191,8 @@ DiskIoDriverBindingStart (
     goto ErrorExit;
   }
 
+  DiskIoCacheInit (Instance, ControllerHandle);
+
   //
   // Install protocol interfaces for the Disk IO device.
   //
@@ -217,6 +224,7 @@ ErrorExit:
     }
 
     if (Instance != NULL) {
+      DiskIoCacheFree (Instance);
       FreePool (Instance);
     }
 
@@ -330,6 +338,9 @@ DiskIoDriverBindingStop (
       EFI_SIZE_TO_PAGES (PcdGet32 (PcdDiskIoDataBufferBlockNum) * Instance->BlockIo->Media->BlockSize)
       );
 
+    DiskIoCacheFree (Instance);
+    DiskIoFreeBlockBufferPool (Instance);
+
     Status = gBS->CloseProtocol (
                     ControllerHandle,
                     &gEfiBlockIoProtocolGuid,
@@ -353,6 +364,478 @@ DiskIoDriverBindingStop (
   return Status;
 }
 
+/**
+  Allocate the block cache of the instance if it is enabled by
+  PcdDiskIoCacheBlockNum. The instance works without the cache if the
+  memory is not available.
+
+  The disk of the instance is named by its device path up to the first
+  partition node, so the whole disk and its partitions share the same one.
+
+  @param Instance          Pointer to the DISK_IO_PRIVATE_DATA.
+  @param ControllerHandle  Handle of the device the instance is started on.
+**/
+VOID
+DiskIoCacheInit (
+  IN OUT DISK_IO_PRIVATE_DATA  *Instance,
+  IN     EFI_HANDLE            ControllerHandle
+  )
+{
+  DISK_IO_CACHE             *Cache;
+  EFI_BLOCK_IO_MEDIA        *Media;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  EFI_DEVICE_PATH_PROTOCOL  *Node;
+  EFI_STATUS                Status;
+
+  Cache = &Instance->Cache;
+  Media = Instance->BlockIo->Media;
+  ZeroMem (Cache, sizeof (DISK_IO_CACHE));
+
+  Status = gBS->HandleProtocol (ControllerHandle, &gEfiDevicePathProtocolGuid, (VOID **)&DevicePath);
+  if (!EFI_ERROR (Status)) {
+    for (Node = DevicePath; !IsDevicePathEnd (Node); Node = NextDevicePathNode (Node)) {
+      if ((DevicePathType (Node) == MEDIA_DEVICE_PATH) &&
+          ((DevicePathSubType (Node) == MEDIA_HARDDRIVE_DP) || (DevicePathSubType (Node) == MEDIA_CDROM_DP)))
+      {
+        break;
+      }
+    }
+
+    Cache->DiskPathSize = (UINTN)Node - (UINTN)DevicePath;
+    Cache->DiskPath     = AllocateCopyPool (Cache->DiskPathSize, DevicePath);
+  }
+
+  Cache->LineBlocks = MAX (1, DISK_IO_CACHE_LINE_SIZE / Media->BlockSize);
+  Cache->LineSize   = Cache->LineBlocks * Media->BlockSize;
+  Cache->LineNum    = PcdGet32 (PcdDiskIoCacheBlockNum) / Cache->LineBlocks;
+
+  //
+  // Lines are read into directly, so each of them must meet the alignment
+  // requirement of the device.
+  //
+  if ((Cache->LineNum == 0) ||
+      ((Media->IoAlign > 1) && ((Cache->LineSize % Media->IoAlign) != 0)))
+  {
+    Cache->LineNum = 0;
+    return;
+  }
+
+  Cache->Lines = AllocateZeroPool (Cache->LineNum * sizeof (DISK_IO_CACHE_LINE));
+  Cache->Data  = AllocateAlignedPages (
+                   EFI_SIZE_TO_PAGES ((UINTN)Cache->LineNum * Cache->LineSize),
+                   Media->IoAlign
+                   );
+  if ((Cache->Lines == NULL) || (Cache->Data == NULL)) {
+    DiskIoCacheFree (Instance);
+    return;
+  }
+
+  Cache->MediaId = Media->MediaId;
+  Cache->NextLba = MAX_UINT64;
+  InsertTailList (&mDiskIoCacheList, &Cache->Link);
+}
+
+/**
+  Free the block cache of the instance.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheFree (
+  IN OUT DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  DISK_IO_CACHE  *Cache;
+
+  Cache = &Instance->Cache;
+  if (Cache->LineNum != 0) {
+    DEBUG ((DEBUG_INFO, "DiskIo: Cache hits %Lu, misses %Lu\n", Cache->Hits, Cache->Misses));
+  }
+
+  if (Cache->Link.ForwardLink != NULL) {
+    RemoveEntryList (&Cache->Link);
+  }
+
+  if (Cache->DiskPath != NULL) {
+    FreePool (Cache->DiskPath);
+  }
+
+  if (Cache->Lines != NULL) {
+    FreePool (Cache->Lines);
+  }
+
+  if (Cache->Data != NULL) {
+    FreeAlignedPages (Cache->Data, EFI_SIZE_TO_PAGES ((UINTN)Cache->LineNum * Cache->LineSize));
+  }
+
+  ZeroMem (Cache, sizeof (DISK_IO_CACHE));
+}
+
+/**
+  Check whether two caches belong to instances on the same disk. A cache
+  whose disk is unknown is taken to be on every disk.
+
+  @param Cache        Pointer to the DISK_IO_CACHE.
+  @param OtherCache   Pointer to the other DISK_IO_CACHE.
+
+  @retval TRUE        The caches may hold data of the same disk.
+  @retval FALSE       The caches hold data of different disks.
+**/
+BOOLEAN
+DiskIoCacheOnSameDisk (
+  IN DISK_IO_CACHE  *Cache,
+  IN DISK_IO_CACHE  *OtherCache
+  )
+{
+  if ((Cache->DiskPath == NULL) || (OtherCache->DiskPath == NULL)) {
+    return TRUE;
+  }
+
+  return (BOOLEAN)((Cache->DiskPathSize == OtherCache->DiskPathSize) &&
+                   (CompareMem (Cache->DiskPath, OtherCache->DiskPath, Cache->DiskPathSize) == 0));
+}
+
+/**
+  Drop the cached data overlapping a range of the device. The other
+  instances on the same disk address it at other offsets, so all their
+  cached data is dropped.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Offset       The starting byte offset of the range.
+  @param Length       The size in bytes of the range.
+**/
+VOID
+DiskIoCacheInvalidate (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT64                Offset,
+  IN UINTN                 Length
+  )
+{
+  DISK_IO_CACHE       *Cache;
+  DISK_IO_CACHE       *OtherCache;
+  DISK_IO_CACHE_LINE  *Line;
+  LIST_ENTRY          *Link;
+  UINT64              Index;
+  UINT64              LastIndex;
+
+  Cache = &Instance->Cache;
+  if (Length == 0) {
+    return;
+  }
+
+  BASE_LIST_FOR_EACH (Link, &mDiskIoCacheList) {
+    OtherCache = BASE_CR (Link, DISK_IO_CACHE, Link);
+    if ((OtherCache != Cache) && DiskIoCacheOnSameDisk (Cache, OtherCache)) {
+      ZeroMem (OtherCache->Lines, OtherCache->LineNum * sizeof (DISK_IO_CACHE_LINE));
+      OtherCache->NextLba = MAX_UINT64;
+    }
+  }
+
+  if (Cache->LineNum == 0) {
+    return;
+  }
+
+  Index     = DivU64x32 (Offset, Cache->LineSize);
+  LastIndex = DivU64x32 (Offset + Length - 1, Cache->LineSize);
+  if (LastIndex - Index >= Cache->LineNum) {
+    ZeroMem (Cache->Lines, Cache->LineNum * sizeof (DISK_IO_CACHE_LINE));
+    return;
+  }
+
+  for ( ; Index <= LastIndex; Index++) {
+    Line = &Cache->Lines[ModU64x32 (Index, Cache->LineNum)];
+    if (Line->Lba == MultU64x32 (Index, Cache->LineBlocks)) {
+      Line->Length = 0;
+    }
+  }
+}
+
+/**
+  Read the line starting at Lba into the cache. If the line follows the
+  previous read, the lines after it are read ahead in the same request.
+  When the read-ahead fails, the line at Lba is read again on its own.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId      ID of the medium to be read.
+  @param Lba          The first block of the line.
+
+  @return The status of the read from the device.
+**/
+EFI_STATUS
+DiskIoCacheFill (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT32                MediaId,
+  IN EFI_LBA               Lba
+  )
+{
+  DISK_IO_CACHE       *Cache;
+  DISK_IO_CACHE_LINE  *Line;
+  EFI_BLOCK_IO_MEDIA  *Media;
+  UINT32              Slot;
+  UINTN               LineCount;
+  UINTN               Blocks;
+  UINTN               Index;
+  UINT8               *ReadBuffer;
+  EFI_STATUS          Status;
+
+  Cache     = &Instance->Cache;
+  Media     = Instance->BlockIo->Media;
+  LineCount = 1;
+  if (Lba == Cache->NextLba) {
+    LineCount = MIN (DISK_IO_CACHE_READ_AHEAD_LINES, Cache->LineNum);
+    LineCount = MIN (LineCount, PcdGet32 (PcdDiskIoDataBufferBlockNum) / Cache->LineBlocks);
+    LineCount = MAX (LineCount, 1);
+  }
+
+  Blocks = (UINTN)MIN ((UINT64)LineCount * Cache->LineBlocks, Media->LastBlock + 1 - Lba);
+  Slot   = ModU64x32 (DivU64x32 (Lba, Cache->LineBlocks), Cache->LineNum);
+
+  //
+  // A single line is read in place, read-ahead goes through the working buffer.
+  //
+  if (LineCount == 1) {
+    ReadBuffer = Cache->Data + (UINTN)Slot * Cache->LineSize;
+  } else {
+    ReadBuffer = Instance->SharedWorkingBuffer;
+  }
+
+  Line         = &Cache->Lines[Slot];
+  Line->Length = 0;
+  Status       = Instance->BlockIo->ReadBlocks (
+                                      Instance->BlockIo,
+                                      MediaId,
+                                      Lba,
+                                      Blocks * Media->BlockSize,
+                                      ReadBuffer
+                                      );
+  if (EFI_ERROR (Status) && (LineCount != 1)) {
+    //
+    // The lines read ahead may cover blocks that cannot be read, such as a
+    // bad sector or the unreadable tail of an optical disc.
+    //
+    LineCount  = 1;
+    Blocks     = MIN (Blocks, Cache->LineBlocks);
+    ReadBuffer = Cache->Data + (UINTN)Slot * Cache->LineSize;
+    Status     = Instance->BlockIo->ReadBlocks (
+                                      Instance->BlockIo,
+                                      MediaId,
+                                      Lba,
+                                      Blocks * Media->BlockSize,
+                                      ReadBuffer
+                                      );
+  }
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  for (Index = 0; Index * Cache->LineBlocks < Blocks; Index++) {
+    Slot = ModU64x32 (DivU64x32 (Lba, Cache->LineBlocks), Cache->LineNum);
+    Line = &Cache->Lines[Slot];
+    if (LineCount != 1) {
+      CopyMem (
+        Cache->Data + (UINTN)Slot * Cache->LineSize,
+        ReadBuffer + Index * Cache->LineSize,
+        MIN (Cache->LineBlocks, Blocks - Index * Cache->LineBlocks) * Media->BlockSize
+        );
+    }
+
+    Line->Lba    = Lba;
+    Line->Length = MIN (Cache->LineBlocks, Blocks - Index * Cache->LineBlocks) * Media->BlockSize;
+    Lba         += Cache->LineBlocks;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Serve a blocking read from the block cache.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId      ID of the medium to be read.
+  @param Offset       The starting byte offset to read from the device.
+  @param BufferSize   The size in bytes of Buffer.
+  @param Buffer       A pointer to the destination buffer for the data.
+  @param Status       The status of the read if it was served from the cache.
+
+  @retval TRUE        The read was served from the cache, Status is returned.
+  @retval FALSE       The read is not cacheable, or the cache could not be
+                      filled, and must be sent to the device.
+**/
+BOOLEAN
+DiskIoCacheRead (
+  IN  DISK_IO_PRIVATE_DATA  *Instance,
+  IN  UINT32                MediaId,
+  IN  UINT64                Offset,
+  IN  UINTN                 BufferSize,
+  OUT UINT8                 *Buffer,
+  OUT EFI_STATUS            *Status
+  )
+{
+  DISK_IO_CACHE       *Cache;
+  DISK_IO_CACHE_LINE  *Line;
+  EFI_BLOCK_IO_MEDIA  *Media;
+  UINT64              MediaSize;
+  UINT64              Index;
+  UINT32              LineOffset;
+  UINT32              Slot;
+  EFI_LBA             Lba;
+  UINTN               Length;
+  UINT64              ReadOffset;
+  UINTN               ReadSize;
+
+  Cache = &Instance->Cache;
+  Media = Instance->BlockIo->Media;
+  if ((Cache->LineNum == 0) || (BufferSize == 0) ||
+      (BufferSize > DISK_IO_CACHE_MAX_READ_LINES * Cache->LineSize) ||
+      !Media->MediaPresent || (MediaId != Media->MediaId))
+  {
+    return FALSE;
+  }
+
+  //
+  // Leave requests beyond the end of the media to the device to fail.
+  //
+  MediaSize = MultU64x32 (Media->LastBlock + 1, Media->BlockSize);
+  if ((Offset >= MediaSize) || (BufferSize > MediaSize - Offset)) {
+    return FALSE;
+  }
+
+  if (Cache->MediaId != Media->MediaId) {
+    ZeroMem (Cache->Lines, Cache->LineNum * sizeof (DISK_IO_CACHE_LINE));
+    Cache->MediaId = Media->MediaId;
+  }
+
+  ReadOffset = Offset;
+  ReadSize   = BufferSize;
+  *Status    = EFI_SUCCESS;
+  while (BufferSize > 0) {
+    Index = DivU64x32Remainder (Offset, Cache->LineSize, &LineOffset);
+    Lba   = MultU64x32 (Index, Cache->LineBlocks);
+    Slot  = ModU64x32 (Index, Cache->LineNum);
+    Line  = &Cache->Lines[Slot];
+
+    if ((Line->Length == 0) || (Line->Lba != Lba)) {
+      Cache->Misses++;
+      if (EFI_ERROR (DiskIoCacheFill (Instance, MediaId, Lba))) {
+        //
+        // Let the device read the request without the cache, so it fails
+        // or succeeds exactly as it would with the cache disabled.
+        //
+        DiskIoCacheInvalidate (Instance, ReadOffset, ReadSize);
+        Cache->NextLba = MAX_UINT64;
+        return FALSE;
+      }
+    } else {
+      Cache->Hits++;
+    }
+
+    ASSERT (LineOffset < Line->Length);
+    Length = MIN (BufferSize, Line->Length - LineOffset);
+    CopyMem (Buffer, Cache->Data + (UINTN)Slot * Cache->LineSize + LineOffset, Length);
+
+    Buffer         += Length;
+    Offset         += Length;
+    BufferSize     -= Length;
+    Cache->NextLba  = Lba + Cache->LineBlocks;
+  }
+
+  return TRUE;
+}
+
+/**
+  Get a one block working buffer, reusing one released by a previous request
+  when available.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+
+  @return A pointer to the buffer, or NULL if it cannot be allocated.
+**/
+VOID *
+DiskIoAllocateBlockBuffer (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  VOID     *Buffer;
+  UINTN    Index;
+  EFI_TPL  OldTpl;
+
+  Buffer = NULL;
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  for (Index = 0; Index < DISK_IO_BLOCK_BUFFER_POOL_SIZE; Index++) {
+    if (Instance->BlockBufferPool[Index] != NULL) {
+      Buffer                            = Instance->BlockBufferPool[Index];
+      Instance->BlockBufferPool[Index] = NULL;
+      break;
+    }
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (Buffer == NULL) {
+    Buffer = AllocateAlignedPages (
+               EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize),
+               MAX (Instance->BlockIo->Media->IoAlign, 1)
+               );
+  }
+
+  return Buffer;
+}
+
+/**
+  Release a one block working buffer got from DiskIoAllocateBlockBuffer().
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Buffer       The buffer to release.
+**/
+VOID
+DiskIoFreeBlockBuffer (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN VOID                  *Buffer
+  )
+{
+  UINTN    Index;
+  EFI_TPL  OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  for (Index = 0; Index < DISK_IO_BLOCK_BUFFER_POOL_SIZE; Index++) {
+    if (Instance->BlockBufferPool[Index] == NULL) {
+      Instance->BlockBufferPool[Index] = Buffer;
+      Buffer                            = NULL;
+      break;
+    }
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (Buffer != NULL) {
+    FreeAlignedPages (Buffer, EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize));
+  }
+}
+
+/**
+  Free the one block working buffers kept by the instance.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoFreeBlockBufferPool (
+  IN OUT DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < DISK_IO_BLOCK_BUFFER_POOL_SIZE; Index++) {
+    if (Instance->BlockBufferPool[Index] != NULL) {
+      FreeAlignedPages (
+        Instance->BlockBufferPool[Index],
+        EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize)
+        );
+      Instance->BlockBufferPool[Index] = NULL;
+    }
+  }
+}
+
 /**
   Destroy the sub task.
 
@@ -380,12 +863,11 @@ DiskIoDestroySubtask (
 
   if (!Subtask->Blocking) {
     if (Subtask->WorkingBuffer != NULL) {
-      FreeAlignedPages (
-        Subtask->WorkingBuffer,
-        Subtask->Length < Instance->BlockIo->Media->BlockSize
-        ? EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize)
-        : EFI_SIZE_TO_PAGES (Subtask->Length)
-        );
+      if (Subtask->Length < Instance->BlockIo->Media->BlockSize) {
+        DiskIoFreeBlockBuffer (Instance, Subtask->WorkingBuffer);
+      } else {
+        FreeAlignedPages (Subtask->WorkingBuffer, EFI_SIZE_TO_PAGES (Subtask->Length));
+      }
     }
 
     if (Subtask->BlockIo2Token.Event != NULL) {
@@ -588,7 +1070,7 @@ DiskIoCreateSubtaskList (
     if (Blocking) {
       WorkingBuffer = SharedWorkingBuffer;
     } else {
-      WorkingBuffer = AllocateAlignedPages (EFI_SIZE_TO_PAGES (BlockSize), IoAlign);
+      WorkingBuffer = DiskIoAllocateBlockBuffer (Instance);
       if (WorkingBuffer == NULL) {
         goto Done;
       }
@@ -627,7 +1109,7 @@ DiskIoCreateSubtaskList (
     if (Blocking) {
       WorkingBuffer = SharedWorkingBuffer;
     } else {
-      WorkingBuffer = AllocateAlignedPages (EFI_SIZE_TO_PAGES (BlockSize), IoAlign);
+      WorkingBuffer = DiskIoAllocateBlockBuffer (Instance);
       if (WorkingBuffer == NULL) {
         goto Done;
       }
@@ -866,6 +1348,10 @@ DiskIo2ReadWriteDisk (
     while (!DiskIo2RemoveCompletedTask (Instance)) {
     }
 
+    if (!Write && DiskIoCacheRead (Instance, MediaId, Offset, BufferSize, Buffer, &Status)) {
+      return Status;
+    }
+
     SubtasksPtr = &Subtasks;
   } else {
     DiskIo2RemoveCompletedTask (Instance);
@@ -886,6 +1372,34 @@ DiskIo2ReadWriteDisk (
     SubtasksPtr = &Task->Subtasks;
   }
 
+  //
+  // The cache is write-through, drop the data being overwritten.
+  //
+  if (Write) {
+    DiskIoCacheInvalidate (Instance, Offset, BufferSize);
+  }
+
+  //
+  // A blocking request on block boundaries with a buffer meeting the
+  // alignment requirement maps directly to a single Block I/O request, so
+  // there is no need to build a subtask list for it.
+  //
+  if (Blocking &&
+      (ModU64x32 (Offset, Media->BlockSize) == 0) &&
+      ((BufferSize % Media->BlockSize) == 0) &&
+      ((Media->IoAlign <= 1) || (ALIGN_POINTER (Buffer, Media->IoAlign) == Buffer)))
+  {
+    SubtaskPerformTpl = gBS->RaiseTPL (TPL_CALLBACK);
+    if (Write) {
+      Status = BlockIo->WriteBlocks (BlockIo, MediaId, DivU64x32 (Offset, Media->BlockSize), BufferSize, Buffer);
+    } else {
+      Status = BlockIo->ReadBlocks (BlockIo, MediaId, DivU64x32 (Offset, Media->BlockSize), BufferSize, Buffer);
+    }
+
+    gBS->RestoreTPL (SubtaskPerformTpl);
+    return Status;
+  }
+
   InitializeListHead (SubtasksPtr);
   if (!DiskIoCreateSubtaskList (Instance, Write, Offset, BufferSize, Buffer, Blocking, Instance->SharedWorkingBuffer, SubtasksPtr)) {
     if (Task != NULL) {
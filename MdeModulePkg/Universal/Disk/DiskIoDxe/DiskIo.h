@@ -16,6 +16,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/ComponentName.h>
 #include <Protocol/DriverBinding.h>
 #include <Protocol/DiskIo.h>
+#include <Protocol/DevicePath.h>
 #include <Library/DebugLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/UefiLib.h>
@@ -23,6 +24,46 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/PcdLib.h>
+#include <Library/DevicePathLib.h>
+
+//
+// Block cache, enabled by PcdDiskIoCacheBlockNum.
+// Blocking reads of up to DISK_IO_CACHE_MAX_READ_LINES lines are served
+// from the cache, and a miss on the line following the previous read
+// fetches DISK_IO_CACHE_READ_AHEAD_LINES lines at once.
+// The whole disk and its partitions have their own instances, so a write
+// through one of them drops the cached data of all the others on the disk.
+//
+#define DISK_IO_CACHE_LINE_SIZE           SIZE_4KB
+#define DISK_IO_CACHE_MAX_READ_LINES      8
+#define DISK_IO_CACHE_READ_AHEAD_LINES    8
+
+typedef struct {
+  EFI_LBA    Lba;                           ///< First block of the cached data
+  UINTN      Length;                        ///< Bytes of cached data, 0 if the line is empty
+} DISK_IO_CACHE_LINE;
+
+typedef struct {
+  UINT32                LineBlocks;         ///< Blocks per line
+  UINT32                LineSize;           ///< Bytes per line
+  UINT32                LineNum;            ///< Number of lines, 0 if the cache is disabled
+  DISK_IO_CACHE_LINE    *Lines;
+  UINT8                 *Data;
+  UINT32                MediaId;            ///< Media the cached data belongs to
+  EFI_LBA               NextLba;            ///< Line following the previous read
+  UINT64                Hits;
+  UINT64                Misses;
+  LIST_ENTRY            Link;               ///< Link in the list of enabled caches
+  VOID                  *DiskPath;          ///< Device path of the disk, NULL if unknown
+  UINTN                 DiskPathSize;       ///< Bytes of DiskPath
+} DISK_IO_CACHE;
+
+//
+// Number of one block working buffers kept for reuse by non-blocking requests
+// which do not start or end on a block boundary.
+//
+#define DISK_IO_BLOCK_BUFFER_POOL_SIZE  8
 
 #define DISK_IO_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('d', 's', 'k', 'I')
 typedef struct {
@@ -34,9 +75,12 @@ typedef struct {
   EFI_BLOCK_IO2_PROTOCOL    *BlockIo2;
 
   UINT8                     *SharedWorkingBuffer;
+  VOID                      *BlockBufferPool[DISK_IO_BLOCK_BUFFER_POOL_SIZE];
 
   EFI_LOCK                  TaskQueueLock;
   LIST_ENTRY                TaskQueue;
+
+  DISK_IO_CACHE             Cache;
 } DISK_IO_PRIVATE_DATA;
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO(a)   CR (a, DISK_IO_PRIVATE_DATA, DiskIo,  DISK_IO_PRIVATE_DATA_SIGNATURE)
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO2(a)  CR (a, DISK_IO_PRIVATE_DATA, DiskIo2, DISK_IO_PRIVATE_DATA_SIGNATURE)
@@ -160,6 +204,40 @@ DiskIoDriverBindingStop (
   IN  EFI_HANDLE                   *ChildHandleBuffer
   );
 
+/**
+  Allocate the block cache of the instance if it is enabled by
+  PcdDiskIoCacheBlockNum. The instance works without the cache if the
+  memory is not available.
+
+  @param Instance          Pointer to the DISK_IO_PRIVATE_DATA.
+  @param ControllerHandle  Handle of the device the instance is started on.
+**/
+VOID
+DiskIoCacheInit (
+  IN OUT DISK_IO_PRIVATE_DATA  *Instance,
+  IN     EFI_HANDLE            ControllerHandle
+  );
+
+/**
+  Free the one block working buffers kept by the instance.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoFreeBlockBufferPool (
+  IN OUT DISK_IO_PRIVATE_DATA  *Instance
+  );
+
+/**
+  Free the block cache of the instance.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheFree (
+  IN OUT DISK_IO_PRIVATE_DATA  *Instance
+  );
+
 //
 // Disk I/O Protocol Interface
 //
@@ -21,6 +21,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "Partition.h"
 
+//
+// Size of the partition entry array read together with a GPT header. This is
+// the minimum size of the array required by the UEFI specification.
+//
+#define GPT_ENTRY_ARRAY_PREFETCH_SIZE  SIZE_16KB
+
 /**
   Install child handles if the Handle supports GPT partition structure.
 
@@ -32,6 +38,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
   @param[in]  DiskIo      Disk Io protocol.
   @param[in]  Lba         The starting Lba of the Partition Table
   @param[out] PartHeader  Stores the partition table that is read
+  @param[out] PartEntry   Optionally returns the partition entry array that
+                          was validated. The caller must free it.
 
   @retval TRUE      The partition table is valid
   @retval FALSE     The partition table is not valid
@@ -42,16 +50,16 @@ PartitionValidGptTable (
   IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
   IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
   IN  EFI_LBA                     Lba,
-  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader
+  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  OUT EFI_PARTITION_ENTRY         **PartEntry OPTIONAL
   );
 
 /**
   Check if the CRC field in the Partition table header is valid
   for Partition entry array.
 
-  @param[in]  BlockIo     Parent BlockIo interface
-  @param[in]  DiskIo      Disk Io Protocol.
   @param[in]  PartHeader  Partition table header structure
+  @param[in]  PartEntry   Partition entry array of the header
 
   @retval TRUE      the CRC is valid
   @retval FALSE     the CRC is invalid
@@ -59,9 +67,8 @@ PartitionValidGptTable (
 **/
 BOOLEAN
 PartitionCheckGptEntryArrayCRC (
-  IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
-  IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
-  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader
+  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  IN  EFI_PARTITION_ENTRY         *PartEntry
   );
 
 /**
@@ -285,10 +292,10 @@ PartitionInstallGptChildHandles (
   //
   // Check primary and backup partition tables
   //
-  if (!PartitionValidGptTable (BlockIo, DiskIo, PRIMARY_PART_HEADER_LBA, PrimaryHeader)) {
+  if (!PartitionValidGptTable (BlockIo, DiskIo, PRIMARY_PART_HEADER_LBA, PrimaryHeader, &PartEntry)) {
     DEBUG ((DEBUG_INFO, " Not Valid primary partition table\n"));
 
-    if (!PartitionValidGptTable (BlockIo, DiskIo, LastBlock, BackupHeader)) {
+    if (!PartitionValidGptTable (BlockIo, DiskIo, LastBlock, BackupHeader, NULL)) {
       DEBUG ((DEBUG_INFO, " Not Valid backup partition table\n"));
       goto Done;
     } else {
@@ -298,18 +305,18 @@ PartitionInstallGptChildHandles (
         DEBUG ((DEBUG_INFO, " Restore primary partition table error\n"));
       }
 
-      if (PartitionValidGptTable (BlockIo, DiskIo, BackupHeader->AlternateLBA, PrimaryHeader)) {
+      if (PartitionValidGptTable (BlockIo, DiskIo, BackupHeader->AlternateLBA, PrimaryHeader, &PartEntry)) {
         DEBUG ((DEBUG_INFO, " Restore backup partition table success\n"));
       }
     }
-  } else if (!PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader)) {
+  } else if (!PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader, NULL)) {
     DEBUG ((DEBUG_INFO, " Valid primary and !Valid backup partition table\n"));
     DEBUG ((DEBUG_INFO, " Restore backup partition table by the primary\n"));
     if (!PartitionRestoreGptTable (BlockIo, DiskIo, PrimaryHeader)) {
       DEBUG ((DEBUG_INFO, " Restore backup partition table error\n"));
     }
 
-    if (PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader)) {
+    if (PartitionValidGptTable (BlockIo, DiskIo, PrimaryHeader->AlternateLBA, BackupHeader, NULL)) {
       DEBUG ((DEBUG_INFO, " Restore backup partition table success\n"));
     }
   }
@@ -317,25 +324,28 @@ PartitionInstallGptChildHandles (
   DEBUG ((DEBUG_INFO, " Valid primary and Valid backup partition table\n"));
 
   //
-  // Read the EFI Partition Entries
+  // Read the EFI Partition Entries, unless they were kept from the
+  // validation of the primary partition table
   //
-  PartEntry = AllocatePool (PrimaryHeader->NumberOfPartitionEntries * PrimaryHeader->SizeOfPartitionEntry);
   if (PartEntry == NULL) {
-    DEBUG ((DEBUG_ERROR, "Allocate pool error\n"));
-    goto Done;
-  }
+    PartEntry = AllocatePool (PrimaryHeader->NumberOfPartitionEntries * PrimaryHeader->SizeOfPartitionEntry);
+    if (PartEntry == NULL) {
+      DEBUG ((DEBUG_ERROR, "Allocate pool error\n"));
+      goto Done;
+    }
 
-  Status = DiskIo->ReadDisk (
-                     DiskIo,
-                     MediaId,
-                     MultU64x32 (PrimaryHeader->PartitionEntryLBA, BlockSize),
-                     PrimaryHeader->NumberOfPartitionEntries * (PrimaryHeader->SizeOfPartitionEntry),
-                     PartEntry
-                     );
-  if (EFI_ERROR (Status)) {
-    GptValidStatus = Status;
-    DEBUG ((DEBUG_ERROR, " Partition Entry ReadDisk error\n"));
-    goto Done;
+    Status = DiskIo->ReadDisk (
+                       DiskIo,
+                       MediaId,
+                       MultU64x32 (PrimaryHeader->PartitionEntryLBA, BlockSize),
+                       PrimaryHeader->NumberOfPartitionEntries * (PrimaryHeader->SizeOfPartitionEntry),
+                       PartEntry
+                       );
+    if (EFI_ERROR (Status)) {
+      GptValidStatus = Status;
+      DEBUG ((DEBUG_ERROR, " Partition Entry ReadDisk error\n"));
+      goto Done;
+    }
   }
 
   DEBUG ((DEBUG_INFO, " Partition entries read block success\n"));
@@ -454,10 +464,16 @@ Done:
   The GPT partition table header is external input, so this routine
   will do basic validation for GPT partition table header before return.
 
+  The header is read together with the blocks where the partition entry
+  array is normally recorded (right after the primary header, right before
+  the backup header), so a standard layout is read with a single request.
+
   @param[in]  BlockIo     Parent BlockIo interface.
   @param[in]  DiskIo      Disk Io protocol.
   @param[in]  Lba         The starting Lba of the Partition Table
   @param[out] PartHeader  Stores the partition table that is read
+  @param[out] PartEntry   Optionally returns the partition entry array that
+                          was validated. The caller must free it.
 
   @retval TRUE      The partition table is valid
   @retval FALSE     The partition table is not valid
@@ -468,19 +484,40 @@ PartitionValidGptTable (
   IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
   IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
   IN  EFI_LBA                     Lba,
-  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader
+  OUT EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  OUT EFI_PARTITION_ENTRY         **PartEntry OPTIONAL
   )
 {
   EFI_STATUS                  Status;
   UINT32                      BlockSize;
+  EFI_LBA                     LastBlock;
   EFI_PARTITION_TABLE_HEADER  *PartHdr;
   UINT32                      MediaId;
+  UINT8                       *Buffer;
+  EFI_LBA                     StartLba;
+  UINTN                       ReadBlocks;
+  UINTN                       PrefetchBlocks;
+  UINTN                       EntryArraySize;
+  EFI_PARTITION_ENTRY         *Entry;
 
   BlockSize = BlockIo->Media->BlockSize;
+  LastBlock = BlockIo->Media->LastBlock;
   MediaId   = BlockIo->Media->MediaId;
-  PartHdr   = AllocateZeroPool (BlockSize);
 
-  if (PartHdr == NULL) {
+  StartLba       = Lba;
+  ReadBlocks     = 1;
+  PrefetchBlocks = (GPT_ENTRY_ARRAY_PREFETCH_SIZE + BlockSize - 1) / BlockSize;
+  if (Lba == PRIMARY_PART_HEADER_LBA) {
+    if (Lba + PrefetchBlocks <= LastBlock) {
+      ReadBlocks += PrefetchBlocks;
+    }
+  } else if ((Lba <= LastBlock) && (Lba > PrefetchBlocks)) {
+    StartLba    = Lba - PrefetchBlocks;
+    ReadBlocks += PrefetchBlocks;
+  }
+
+  Buffer = AllocateZeroPool (ReadBlocks * BlockSize);
+  if (Buffer == NULL) {
     DEBUG ((DEBUG_ERROR, "Allocate pool error\n"));
     return FALSE;
   }
@@ -491,15 +528,16 @@ PartitionValidGptTable (
   Status = DiskIo->ReadDisk (
                      DiskIo,
                      MediaId,
-                     MultU64x32 (Lba, BlockSize),
-                     BlockSize,
-                     PartHdr
+                     MultU64x32 (StartLba, BlockSize),
+                     ReadBlocks * BlockSize,
+                     Buffer
                      );
   if (EFI_ERROR (Status)) {
-    FreePool (PartHdr);
+    FreePool (Buffer);
     return FALSE;
   }
 
+  PartHdr = (EFI_PARTITION_TABLE_HEADER *)(Buffer + (UINTN)(Lba - StartLba) * BlockSize);
   if ((PartHdr->Header.Signature != EFI_PTAB_HEADER_ID) ||
       !PartitionCheckCrc (BlockSize, &PartHdr->Header) ||
       (PartHdr->MyLBA != Lba) ||
@@ -507,7 +545,7 @@ PartitionValidGptTable (
       )
   {
     DEBUG ((DEBUG_INFO, "Invalid efi partition table header\n"));
-    FreePool (PartHdr);
+    FreePool (Buffer);
     return FALSE;
   }
 
@@ -515,18 +553,62 @@ PartitionValidGptTable (
   // Ensure the NumberOfPartitionEntries * SizeOfPartitionEntry doesn't overflow.
   //
   if (PartHdr->NumberOfPartitionEntries > DivU64x32 (MAX_UINTN, PartHdr->SizeOfPartitionEntry)) {
-    FreePool (PartHdr);
+    FreePool (Buffer);
     return FALSE;
   }
 
   CopyMem (PartHeader, PartHdr, sizeof (EFI_PARTITION_TABLE_HEADER));
-  if (!PartitionCheckGptEntryArrayCRC (BlockIo, DiskIo, PartHeader)) {
-    FreePool (PartHdr);
+
+  //
+  // Get the EFI Partition Entries from the blocks read with the header,
+  // or read them when they are recorded elsewhere
+  //
+  EntryArraySize = PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry;
+  Entry          = AllocatePool (EntryArraySize);
+  if (Entry == NULL) {
+    DEBUG ((DEBUG_ERROR, " Allocate pool error\n"));
+    FreePool (Buffer);
+    return FALSE;
+  }
+
+  if ((PartHeader->PartitionEntryLBA >= StartLba) &&
+      (PartHeader->PartitionEntryLBA - StartLba < ReadBlocks) &&
+      (EntryArraySize <= (ReadBlocks - (UINTN)(PartHeader->PartitionEntryLBA - StartLba)) * BlockSize))
+  {
+    CopyMem (Entry, Buffer + (UINTN)(PartHeader->PartitionEntryLBA - StartLba) * BlockSize, EntryArraySize);
+  } else {
+    Status = DiskIo->ReadDisk (
+                       DiskIo,
+                       MediaId,
+                       MultU64x32 (PartHeader->PartitionEntryLBA, BlockSize),
+                       EntryArraySize,
+                       Entry
+                       );
+    if (EFI_ERROR (Status)) {
+      FreePool (Entry);
+      FreePool (Buffer);
+      return FALSE;
+    }
+  }
+
+  FreePool (Buffer);
+
+  if (!PartitionCheckGptEntryArrayCRC (PartHeader, Entry)) {
+    FreePool (Entry);
     return FALSE;
   }
 
   DEBUG ((DEBUG_INFO, " Valid efi partition table header\n"));
-  FreePool (PartHdr);
+  if (PartEntry != NULL) {
+    if (*PartEntry != NULL) {
+      FreePool (*PartEntry);
+    }
+
+    *PartEntry = Entry;
+  } else {
+    FreePool (Entry);
+  }
+
   return TRUE;
 }
 
@@ -534,9 +616,8 @@ PartitionValidGptTable (
   Check if the CRC field in the Partition table header is valid
   for Partition entry array.
 
-  @param[in]  BlockIo     Parent BlockIo interface
-  @param[in]  DiskIo      Disk Io Protocol.
   @param[in]  PartHeader  Partition table header structure
+  @param[in]  PartEntry   Partition entry array of the header
 
   @retval TRUE      the CRC is valid
   @retval FALSE     the CRC is invalid
@@ -544,48 +625,22 @@ PartitionValidGptTable (
 **/
 BOOLEAN
 PartitionCheckGptEntryArrayCRC (
-  IN  EFI_BLOCK_IO_PROTOCOL       *BlockIo,
-  IN  EFI_DISK_IO_PROTOCOL        *DiskIo,
-  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader
+  IN  EFI_PARTITION_TABLE_HEADER  *PartHeader,
+  IN  EFI_PARTITION_ENTRY         *PartEntry
   )
 {
   EFI_STATUS  Status;
-  UINT8       *Ptr;
   UINT32      Crc;
   UINTN       Size;
 
-  //
-  // Read the EFI Partition Entries
-  //
-  Ptr = AllocatePool (PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry);
-  if (Ptr == NULL) {
-    DEBUG ((DEBUG_ERROR, " Allocate pool error\n"));
-    return FALSE;
-  }
-
-  Status = DiskIo->ReadDisk (
-                     DiskIo,
-                     BlockIo->Media->MediaId,
-                     MultU64x32 (PartHeader->PartitionEntryLBA, BlockIo->Media->BlockSize),
-                     PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry,
-                     Ptr
-                     );
-  if (EFI_ERROR (Status)) {
-    FreePool (Ptr);
-    return FALSE;
-  }
-
   Size = PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry;
 
-  Status = gBS->CalculateCrc32 (Ptr, Size, &Crc);
+  Status = gBS->CalculateCrc32 (PartEntry, Size, &Crc);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "CheckPEntryArrayCRC: Crc calculation failed\n"));
-    FreePool (Ptr);
     return FALSE;
   }
 
-  FreePool (Ptr);
-
   return (BOOLEAN)(PartHeader->PartitionEntryArrayCRC32 == Crc);
 }
 
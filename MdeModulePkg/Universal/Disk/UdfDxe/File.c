@@ -240,6 +240,11 @@ UdfOpen (
     );
   CopyMem ((VOID *)&NewPrivFileData->File, &File, sizeof (UDF_FILE_INFO));
 
+  //
+  // The extent map belongs to the parent file; build a new one on first read.
+  //
+  ZeroMem (&NewPrivFileData->ExtentMap, sizeof (NewPrivFileData->ExtentMap));
+
   NewPrivFileData->IsRootDirectory = FALSE;
 
   StrCpyS (NewPrivFileData->AbsoluteFileName, UDF_PATH_LENGTH, FilePath);
@@ -383,6 +388,7 @@ UdfRead (
                Volume,
                Parent,
                PrivFileData->FileSize,
+               &PrivFileData->ExtentMap,
                &PrivFileData->FilePosition,
                Buffer,
                &BufferSizeUint64
@@ -572,6 +578,10 @@ UdfClose (
     }
   }
 
+  if (PrivFileData->ExtentMap.Extents != NULL) {
+    FreePool (PrivFileData->ExtentMap.Extents);
+  }
+
   FreePool ((VOID *)PrivFileData);
 
 Exit:
@@ -1053,6 +1053,61 @@ GrowUpBufferToNextAd (
   return EFI_SUCCESS;
 }
 
+/**
+  Append an extent to the extent map of a file.
+
+  The extent is merged into the last one of the map when it directly follows
+  it on the disk, so the data of both can be read with a single request.
+
+  @param[in, out] ExtentMap       Extent map of the file.
+  @param[in]      DiskOffset      Disk offset of the extent in bytes.
+  @param[in]      Length          Length of the extent in bytes.
+
+  @retval EFI_SUCCESS             The extent was added.
+  @retval EFI_OUT_OF_RESOURCES    The map was not grown due to lack of resources.
+
+**/
+EFI_STATUS
+AddFileExtent (
+  IN OUT  UDF_FILE_EXTENT_MAP  *ExtentMap,
+  IN      UINT64               DiskOffset,
+  IN      UINT64               Length
+  )
+{
+  UDF_FILE_EXTENT  *Last;
+  UDF_FILE_EXTENT  *Extents;
+  UINTN            MaxCount;
+
+  if (ExtentMap->Count != 0) {
+    Last = &ExtentMap->Extents[ExtentMap->Count - 1];
+    if (Last->DiskOffset + Last->Length == DiskOffset) {
+      Last->Length += Length;
+      return EFI_SUCCESS;
+    }
+  }
+
+  if (ExtentMap->Count == ExtentMap->MaxCount) {
+    MaxCount = MAX (ExtentMap->MaxCount * 2, 16);
+    Extents  = ReallocatePool (
+                 ExtentMap->MaxCount * sizeof (UDF_FILE_EXTENT),
+                 MaxCount * sizeof (UDF_FILE_EXTENT),
+                 ExtentMap->Extents
+                 );
+    if (Extents == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    ExtentMap->Extents  = Extents;
+    ExtentMap->MaxCount = MaxCount;
+  }
+
+  ExtentMap->Extents[ExtentMap->Count].DiskOffset = DiskOffset;
+  ExtentMap->Extents[ExtentMap->Count].Length     = Length;
+  ExtentMap->Count++;
+
+  return EFI_SUCCESS;
+}
+
 /**
   Read data or size of either a File Entry or an Extended File Entry.
 
@@ -1143,6 +1198,12 @@ ReadFile (
       FilePosition    = 0;
       FinishedSeeking = FALSE;
 
+      break;
+    case ReadFileGetExtents:
+      //
+      // Collect the extents of the file into ReadFileInfo->ExtentMap.
+      //
+      ReadFileInfo->ExtentMap->Count = 0;
       break;
   }
 
@@ -1271,6 +1332,17 @@ ReadFile (
         switch (ReadFileInfo->Flags) {
           case ReadFileGetFileSize:
             ReadFileInfo->ReadLength += ExtentLength;
+            break;
+          case ReadFileGetExtents:
+            Status = AddFileExtent (
+                       ReadFileInfo->ExtentMap,
+                       MultU64x32 (Lsn, LogicalBlockSize),
+                       ExtentLength
+                       );
+            if (EFI_ERROR (Status)) {
+              goto Done;
+            }
+
             break;
           case ReadFileAllocateAndRead:
             //
@@ -2856,6 +2928,7 @@ Out_Free:
   @param[in]      Volume        UDF volume information structure.
   @param[in]      File          File information structure.
   @param[in]      FileSize      Size of the file.
+  @param[in, out] ExtentMap     Extent map of the file, built on the first read.
   @param[in, out] FilePosition  File position.
   @param[in, out] Buffer        File data.
   @param[in, out] BufferSize    Read size.
@@ -2876,34 +2949,111 @@ ReadFileData (
   IN      UDF_VOLUME_INFO        *Volume,
   IN      UDF_FILE_INFO          *File,
   IN      UINT64                 FileSize,
+  IN OUT  UDF_FILE_EXTENT_MAP    *ExtentMap,
   IN OUT  UINT64                 *FilePosition,
   IN OUT  VOID                   *Buffer,
   IN OUT  UINT64                 *BufferSize
   )
 {
-  EFI_STATUS          Status;
-  UDF_READ_FILE_INFO  ReadFileInfo;
+  EFI_STATUS              Status;
+  UDF_READ_FILE_INFO      ReadFileInfo;
+  UDF_FE_RECORDING_FLAGS  RecordingFlags;
+  UINTN                   Index;
+  UINT64                  ExtentStart;
+  UINT64                  Position;
+  UINT64                  Offset;
+  UINT64                  DataOffset;
+  UINT64                  DataLength;
+  UINT64                  BytesLeft;
 
-  ReadFileInfo.Flags        = ReadFileSeekAndRead;
-  ReadFileInfo.FilePosition = *FilePosition;
-  ReadFileInfo.FileData     = Buffer;
-  ReadFileInfo.FileDataSize = *BufferSize;
-  ReadFileInfo.FileSize     = FileSize;
+  //
+  // Collect the extents of a file recorded by ADs once, so the following
+  // reads neither walk nor re-read its (extended) ADs to seek.
+  //
+  RecordingFlags = GET_FE_RECORDING_FLAGS (File->FileEntry);
+  if ((ExtentMap->Extents == NULL) &&
+      ((RecordingFlags == LongAdsSequence) || (RecordingFlags == ShortAdsSequence)))
+  {
+    ReadFileInfo.Flags     = ReadFileGetExtents;
+    ReadFileInfo.ExtentMap = ExtentMap;
 
-  Status = ReadFile (
-             BlockIo,
-             DiskIo,
-             Volume,
-             &File->FileIdentifierDesc->Icb,
-             File->FileEntry,
-             &ReadFileInfo
-             );
-  if (EFI_ERROR (Status)) {
-    return Status;
+    Status = ReadFile (
+               BlockIo,
+               DiskIo,
+               Volume,
+               &File->FileIdentifierDesc->Icb,
+               File->FileEntry,
+               &ReadFileInfo
+               );
+    if (EFI_ERROR (Status) && (ExtentMap->Extents != NULL)) {
+      FreePool (ExtentMap->Extents);
+      ZeroMem (ExtentMap, sizeof (UDF_FILE_EXTENT_MAP));
+    }
+  }
+
+  if (ExtentMap->Extents == NULL) {
+    ReadFileInfo.Flags        = ReadFileSeekAndRead;
+    ReadFileInfo.FilePosition = *FilePosition;
+    ReadFileInfo.FileData     = Buffer;
+    ReadFileInfo.FileDataSize = *BufferSize;
+    ReadFileInfo.FileSize     = FileSize;
+
+    Status = ReadFile (
+               BlockIo,
+               DiskIo,
+               Volume,
+               &File->FileIdentifierDesc->Icb,
+               File->FileEntry,
+               &ReadFileInfo
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    *BufferSize   = ReadFileInfo.FileDataSize;
+    *FilePosition = ReadFileInfo.FilePosition;
+
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Don't read beyond the EOF.
+  //
+  if (*BufferSize > FileSize - *FilePosition) {
+    *BufferSize = FileSize - *FilePosition;
+  }
+
+  Position    = *FilePosition;
+  BytesLeft   = *BufferSize;
+  DataOffset  = 0;
+  ExtentStart = 0;
+  for (Index = 0; (Index < ExtentMap->Count) && (BytesLeft != 0); Index++) {
+    if (ExtentStart + ExtentMap->Extents[Index].Length <= Position) {
+      ExtentStart += ExtentMap->Extents[Index].Length;
+      continue;
+    }
+
+    Offset     = Position - ExtentStart;
+    DataLength = MIN (ExtentMap->Extents[Index].Length - Offset, BytesLeft);
+
+    Status = DiskIo->ReadDisk (
+                       DiskIo,
+                       BlockIo->Media->MediaId,
+                       ExtentMap->Extents[Index].DiskOffset + Offset,
+                       (UINTN)DataLength,
+                       (VOID *)((UINT8 *)Buffer + DataOffset)
+                       );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    DataOffset  += DataLength;
+    Position    += DataLength;
+    BytesLeft   -= DataLength;
+    ExtentStart += ExtentMap->Extents[Index].Length;
   }
 
-  *BufferSize   = ReadFileInfo.FileDataSize;
-  *FilePosition = ReadFileInfo.FilePosition;
+  *FilePosition = Position;
 
   return EFI_SUCCESS;
 }
@@ -134,8 +134,26 @@ typedef enum {
   ReadFileGetFileSize,
   ReadFileAllocateAndRead,
   ReadFileSeekAndRead,
+  ReadFileGetExtents,
 } UDF_READ_FILE_FLAGS;
 
+//
+// A run of file data recorded contiguously on the disk.
+//
+typedef struct {
+  UINT64    DiskOffset;
+  UINT64    Length;
+} UDF_FILE_EXTENT;
+
+//
+// Extents of a file in file order, with physically adjacent extents merged.
+//
+typedef struct {
+  UDF_FILE_EXTENT    *Extents;
+  UINTN              Count;
+  UINTN              MaxCount;
+} UDF_FILE_EXTENT_MAP;
+
 typedef struct {
   VOID                   *FileData;
   UDF_READ_FILE_FLAGS    Flags;
@@ -143,6 +161,7 @@ typedef struct {
   UINT64                 FilePosition;
   UINT64                 FileSize;
   UINT64                 ReadLength;
+  UDF_FILE_EXTENT_MAP    *ExtentMap;
 } UDF_READ_FILE_INFO;
 
 #pragma pack(1)
@@ -353,6 +372,7 @@ typedef struct {
   CHAR16                             FileName[UDF_FILENAME_LENGTH];
   UINT64                             FileSize;
   UINT64                             FilePosition;
+  UDF_FILE_EXTENT_MAP                ExtentMap;
 } PRIVATE_UDF_FILE_DATA;
 
 #define PRIVATE_UDF_SIMPLE_FS_DATA_SIGNATURE  SIGNATURE_32 ('U', 'd', 'f', 's')
@@ -962,6 +982,7 @@ GetVolumeSize (
   @param[in]      Volume        UDF volume information structure.
   @param[in]      File          File information structure.
   @param[in]      FileSize      Size of the file.
+  @param[in, out] ExtentMap     Extent map of the file, built on the first read.
   @param[in, out] FilePosition  File position.
   @param[in, out] Buffer        File data.
   @param[in, out] BufferSize    Read size.
@@ -982,6 +1003,7 @@ ReadFileData (
   IN      UDF_VOLUME_INFO        *Volume,
   IN      UDF_FILE_INFO          *File,
   IN      UINT64                 FileSize,
+  IN OUT  UDF_FILE_EXTENT_MAP    *ExtentMap,
   IN OUT  UINT64                 *FilePosition,
   IN OUT  VOID                   *Buffer,
   IN OUT  UINT64                 *BufferSize
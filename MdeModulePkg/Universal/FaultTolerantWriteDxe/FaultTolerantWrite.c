@@ -331,6 +331,7 @@ FtwWrite (
   UINT8                               *MyBuffer;
   UINTN                               SpareBufferSize;
   UINT8                               *SpareBuffer;
+  BOOLEAN                             SpareErased;
   UINTN                               Index;
   UINT8                               *Ptr;
   EFI_PHYSICAL_ADDRESS                FvbPhysicalAddress;
@@ -529,37 +530,24 @@ FtwWrite (
   //
   // Write the memory buffer to spare block
   // Do not assume Spare Block and Target Block have same block size
+  // The spare block is usually left erased by the previous write, in which
+  // case the erase cycle here can be skipped.
   //
-  Status = FtwEraseSpareBlock (FtwDevice);
-  if (EFI_ERROR (Status)) {
-    FreePool (MyBuffer);
-    FreePool (SpareBuffer);
-    return EFI_ABORTED;
-  }
-
-  Ptr = MyBuffer;
-  for (Index = 0; MyBufferSize > 0; Index += 1) {
-    if (MyBufferSize > FtwDevice->SpareBlockSize) {
-      MyLength = FtwDevice->SpareBlockSize;
-    } else {
-      MyLength = MyBufferSize;
-    }
-
-    Status = FtwDevice->FtwBackupFvb->Write (
-                                        FtwDevice->FtwBackupFvb,
-                                        FtwDevice->FtwSpareLba + Index,
-                                        0,
-                                        &MyLength,
-                                        Ptr
-                                        );
+  SpareErased = IsErasedFlashBuffer (SpareBuffer, SpareBufferSize);
+  if (!SpareErased) {
+    Status = FtwEraseSpareBlock (FtwDevice);
     if (EFI_ERROR (Status)) {
       FreePool (MyBuffer);
       FreePool (SpareBuffer);
       return EFI_ABORTED;
     }
+  }
 
-    Ptr          += MyLength;
-    MyBufferSize -= MyLength;
+  Status = FtwWriteSpareBlock (FtwDevice, MyBuffer, MyBufferSize);
+  if (EFI_ERROR (Status)) {
+    FreePool (MyBuffer);
+    FreePool (SpareBuffer);
+    return EFI_ABORTED;
   }
 
   //
@@ -604,22 +592,12 @@ FtwWrite (
     return EFI_ABORTED;
   }
 
-  Ptr = SpareBuffer;
-  for (Index = 0; Index < FtwDevice->NumberOfSpareBlock; Index += 1) {
-    MyLength = FtwDevice->SpareBlockSize;
-    Status   = FtwDevice->FtwBackupFvb->Write (
-                                          FtwDevice->FtwBackupFvb,
-                                          FtwDevice->FtwSpareLba + Index,
-                                          0,
-                                          &MyLength,
-                                          Ptr
-                                          );
+  if (!SpareErased) {
+    Status = FtwWriteSpareBlock (FtwDevice, SpareBuffer, SpareBufferSize);
     if (EFI_ERROR (Status)) {
       FreePool (SpareBuffer);
       return EFI_ABORTED;
     }
-
-    Ptr += MyLength;
   }
 
   //
@@ -295,6 +295,28 @@ FtwEraseSpareBlock (
   IN EFI_FTW_DEVICE  *FtwDevice
   );
 
+/**
+  Program a memory buffer into the spare block, block by block, starting at
+  the first spare block. The spare block must already be erased.
+
+  Blocks whose content in Buffer is entirely FTW_ERASED_BYTE are skipped, as
+  programming them would leave the freshly erased flash unchanged.
+
+  @param FtwDevice       The private data of FTW driver
+  @param Buffer          The data to program into the spare block
+  @param BufferSize      The size of Buffer, no larger than SpareAreaLength
+
+  @retval EFI_SUCCESS    The buffer was programmed into the spare block
+  @retval Others         Error returned by the FVB Write service
+
+**/
+EFI_STATUS
+FtwWriteSpareBlock (
+  IN EFI_FTW_DEVICE  *FtwDevice,
+  IN UINT8           *Buffer,
+  IN UINTN           BufferSize
+  );
+
 /**
   Retrieve the proper FVB protocol interface by HANDLE.
 
@@ -100,6 +100,64 @@ FtwEraseSpareBlock (
                                     );
 }
 
+/**
+  Program a memory buffer into the spare block, block by block, starting at
+  the first spare block. The spare block must already be erased.
+
+  Blocks whose content in Buffer is entirely FTW_ERASED_BYTE are skipped, as
+  programming them would leave the freshly erased flash unchanged.
+
+  @param FtwDevice       The private data of FTW driver
+  @param Buffer          The data to program into the spare block
+  @param BufferSize      The size of Buffer, no larger than SpareAreaLength
+
+  @retval EFI_SUCCESS    The buffer was programmed into the spare block
+  @retval Others         Error returned by the FVB Write service
+
+**/
+EFI_STATUS
+FtwWriteSpareBlock (
+  IN EFI_FTW_DEVICE  *FtwDevice,
+  IN UINT8           *Buffer,
+  IN UINTN           BufferSize
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Length;
+  UINT8       *Ptr;
+  UINTN       Index;
+
+  ASSERT (BufferSize <= FtwDevice->SpareAreaLength);
+
+  Status = EFI_SUCCESS;
+  Ptr    = Buffer;
+  for (Index = 0; BufferSize > 0; Index += 1) {
+    if (BufferSize > FtwDevice->SpareBlockSize) {
+      Length = FtwDevice->SpareBlockSize;
+    } else {
+      Length = BufferSize;
+    }
+
+    if (!IsErasedFlashBuffer (Ptr, Length)) {
+      Status = FtwDevice->FtwBackupFvb->Write (
+                                          FtwDevice->FtwBackupFvb,
+                                          FtwDevice->FtwSpareLba + Index,
+                                          0,
+                                          &Length,
+                                          Ptr
+                                          );
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
+    Ptr        += Length;
+    BufferSize -= Length;
+  }
+
+  return Status;
+}
+
 /**
 
   Is it in working block?
@@ -379,6 +379,7 @@ FtwReclaimWorkSpace (
   UINTN                                    TempBufferSize;
   UINTN                                    SpareBufferSize;
   UINT8                                    *SpareBuffer;
+  BOOLEAN                                  SpareErased;
   EFI_FAULT_TOLERANT_WORKING_BLOCK_HEADER  *WorkingBlockHeader;
   UINTN                                    Index;
   UINT8                                    *Ptr;
@@ -512,37 +513,23 @@ FtwReclaimWorkSpace (
 
   //
   // Write the memory buffer to spare block
+  // Skip the erase cycle if the spare block is already erased.
   //
-  Status = FtwEraseSpareBlock (FtwDevice);
-  if (EFI_ERROR (Status)) {
-    FreePool (TempBuffer);
-    FreePool (SpareBuffer);
-    return EFI_ABORTED;
-  }
-
-  Ptr = TempBuffer;
-  for (Index = 0; TempBufferSize > 0; Index += 1) {
-    if (TempBufferSize > FtwDevice->SpareBlockSize) {
-      Length = FtwDevice->SpareBlockSize;
-    } else {
-      Length = TempBufferSize;
-    }
-
-    Status = FtwDevice->FtwBackupFvb->Write (
-                                        FtwDevice->FtwBackupFvb,
-                                        FtwDevice->FtwSpareLba + Index,
-                                        0,
-                                        &Length,
-                                        Ptr
-                                        );
+  SpareErased = IsErasedFlashBuffer (SpareBuffer, SpareBufferSize);
+  if (!SpareErased) {
+    Status = FtwEraseSpareBlock (FtwDevice);
     if (EFI_ERROR (Status)) {
       FreePool (TempBuffer);
       FreePool (SpareBuffer);
       return EFI_ABORTED;
     }
+  }
 
-    Ptr            += Length;
-    TempBufferSize -= Length;
+  Status = FtwWriteSpareBlock (FtwDevice, TempBuffer, TempBufferSize);
+  if (EFI_ERROR (Status)) {
+    FreePool (TempBuffer);
+    FreePool (SpareBuffer);
+    return EFI_ABORTED;
   }
 
   //
@@ -603,22 +590,12 @@ FtwReclaimWorkSpace (
     return EFI_ABORTED;
   }
 
-  Ptr = SpareBuffer;
-  for (Index = 0; Index < FtwDevice->NumberOfSpareBlock; Index += 1) {
-    Length = FtwDevice->SpareBlockSize;
-    Status = FtwDevice->FtwBackupFvb->Write (
-                                        FtwDevice->FtwBackupFvb,
-                                        FtwDevice->FtwSpareLba + Index,
-                                        0,
-                                        &Length,
-                                        Ptr
-                                        );
+  if (!SpareErased) {
+    Status = FtwWriteSpareBlock (FtwDevice, SpareBuffer, SpareBufferSize);
     if (EFI_ERROR (Status)) {
       FreePool (SpareBuffer);
       return EFI_ABORTED;
     }
-
-    Ptr += Length;
   }
 
   FreePool (SpareBuffer);
@@ -163,6 +163,163 @@ GetDevicePath (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the length of the <ConfigHdr> at the beginning of a configuration string,
+  that is the GUID, NAME and PATH elements up to the next '&' or the end of string.
+
+  @param  ConfigString           Configuration string beginning with <ConfigHdr>.
+
+  @return The number of characters of the <ConfigHdr>, or 0 if there is no PATH element.
+
+**/
+UINTN
+GetConfigHdrLength (
+  IN EFI_STRING  ConfigString
+  )
+{
+  EFI_STRING  StringPtr;
+
+  StringPtr = StrStr (ConfigString, L"&PATH=");
+  if (StringPtr == NULL) {
+    return 0;
+  }
+
+  for (StringPtr += StrLen (L"&PATH="); *StringPtr != 0 && *StringPtr != L'&'; StringPtr++) {
+  }
+
+  return StringPtr - ConfigString;
+}
+
+/**
+  Get the ConfigRouting cache entry of a <ConfigHdr>.
+
+  @param  Private                Hii database private structure.
+  @param  ConfigHdr              Configuration string beginning with <ConfigHdr>.
+  @param  ConfigHdrLength        Number of characters of the <ConfigHdr>.
+
+  @return The cache entry the <ConfigHdr> is mapped to.
+
+**/
+HII_CONFIG_ROUTING_CACHE_ENTRY *
+GetConfigRoutingCacheEntry (
+  IN HII_DATABASE_PRIVATE_DATA  *Private,
+  IN EFI_STRING                 ConfigHdr,
+  IN UINTN                      ConfigHdrLength
+  )
+{
+  UINT32  Hash;
+  UINTN   Index;
+
+  //
+  // FNV-1a hash of the <ConfigHdr>.
+  //
+  Hash = 0x811C9DC5;
+  for (Index = 0; Index < ConfigHdrLength; Index++) {
+    Hash = (Hash ^ ConfigHdr[Index]) * 0x01000193;
+  }
+
+  return &Private->ConfigRoutingCache[Hash % HII_CONFIG_ROUTING_CACHE_SIZE];
+}
+
+/**
+  Look up the package list whose device path and varstore match the <ConfigHdr>
+  in the ConfigRouting cache.
+
+  @param  Private                Hii database private structure.
+  @param  ConfigHdr              Configuration string beginning with <ConfigHdr>.
+
+  @return The matched database record, or NULL if the <ConfigHdr> is not cached.
+
+**/
+HII_DATABASE_RECORD *
+HiiConfigRoutingCacheLookup (
+  IN HII_DATABASE_PRIVATE_DATA  *Private,
+  IN EFI_STRING                 ConfigHdr
+  )
+{
+  UINTN                           ConfigHdrLength;
+  HII_CONFIG_ROUTING_CACHE_ENTRY  *Entry;
+
+  ConfigHdrLength = GetConfigHdrLength (ConfigHdr);
+  if (ConfigHdrLength == 0) {
+    return NULL;
+  }
+
+  Entry = GetConfigRoutingCacheEntry (Private, ConfigHdr, ConfigHdrLength);
+  if ((Entry->ConfigHdr == NULL) ||
+      (Entry->ConfigHdrLength != ConfigHdrLength) ||
+      (CompareMem (Entry->ConfigHdr, ConfigHdr, ConfigHdrLength * sizeof (CHAR16)) != 0))
+  {
+    return NULL;
+  }
+
+  return Entry->Database;
+}
+
+/**
+  Record the package list whose device path and varstore match the <ConfigHdr>
+  in the ConfigRouting cache. A previous mapping in the same entry is replaced.
+
+  @param  Private                Hii database private structure.
+  @param  ConfigHdr              Configuration string beginning with <ConfigHdr>.
+  @param  Database               The matched database record.
+
+**/
+VOID
+HiiConfigRoutingCacheInsert (
+  IN HII_DATABASE_PRIVATE_DATA  *Private,
+  IN EFI_STRING                 ConfigHdr,
+  IN HII_DATABASE_RECORD        *Database
+  )
+{
+  UINTN                           ConfigHdrLength;
+  HII_CONFIG_ROUTING_CACHE_ENTRY  *Entry;
+
+  ConfigHdrLength = GetConfigHdrLength (ConfigHdr);
+  if (ConfigHdrLength == 0) {
+    return;
+  }
+
+  Entry = GetConfigRoutingCacheEntry (Private, ConfigHdr, ConfigHdrLength);
+  if (Entry->ConfigHdr != NULL) {
+    FreePool (Entry->ConfigHdr);
+  }
+
+  Entry->ConfigHdr = AllocateCopyPool (ConfigHdrLength * sizeof (CHAR16), ConfigHdr);
+  if (Entry->ConfigHdr == NULL) {
+    Entry->Database = NULL;
+    return;
+  }
+
+  Entry->ConfigHdrLength = ConfigHdrLength;
+  Entry->Database        = Database;
+}
+
+/**
+  Remove all the <ConfigHdr> to package list mappings cached by ConfigRouting.
+  It must be called whenever a package list is updated or removed. Adding a
+  package list does not need it: only matches are cached, and a new package
+  list is appended behind the cached ones, so it cannot take precedence.
+
+  @param  Private                Hii database private structure.
+
+**/
+VOID
+HiiConfigRoutingCacheFlush (
+  IN HII_DATABASE_PRIVATE_DATA  *Private
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < HII_CONFIG_ROUTING_CACHE_SIZE; Index++) {
+    if (Private->ConfigRoutingCache[Index].ConfigHdr != NULL) {
+      FreePool (Private->ConfigRoutingCache[Index].ConfigHdr);
+      Private->ConfigRoutingCache[Index].ConfigHdr = NULL;
+      Private->ConfigRoutingCache[Index].Database  = NULL;
+    }
+  }
+}
+
 /**
   Converts the unicode character of the string from uppercase to lowercase.
   This is a internal function.
@@ -5112,23 +5269,31 @@ HiiConfigRoutingExtractConfig (
 
     //
     // Find driver which matches the routing data.
+    // The matching package list of a recently routed <ConfigHdr> is cached,
+    // avoiding to parse the form packages of all the package lists again.
     //
     DriverHandle = NULL;
     HiiHandle    = NULL;
-    Database     = NULL;
-    for (Link = Private->DatabaseList.ForwardLink;
-         Link != &Private->DatabaseList;
-         Link = Link->ForwardLink
-         )
-    {
-      Database = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
-      if ((DevicePathPkg = Database->PackageList->DevicePathPkg) != NULL) {
-        CurrentDevicePath = DevicePathPkg + sizeof (EFI_HII_PACKAGE_HEADER);
-        DevicePathSize    = GetDevicePathSize ((EFI_DEVICE_PATH_PROTOCOL *)CurrentDevicePath);
-        if ((CompareMem (DevicePath, CurrentDevicePath, DevicePathSize) == 0) && IsThisPackageList (Database, ConfigRequest)) {
-          DriverHandle = Database->DriverHandle;
-          HiiHandle    = Database->Handle;
-          break;
+    Database     = HiiConfigRoutingCacheLookup (Private, ConfigRequest);
+    if (Database != NULL) {
+      DriverHandle = Database->DriverHandle;
+      HiiHandle    = Database->Handle;
+    } else {
+      for (Link = Private->DatabaseList.ForwardLink;
+           Link != &Private->DatabaseList;
+           Link = Link->ForwardLink
+           )
+      {
+        Database = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+        if ((DevicePathPkg = Database->PackageList->DevicePathPkg) != NULL) {
+          CurrentDevicePath = DevicePathPkg + sizeof (EFI_HII_PACKAGE_HEADER);
+          DevicePathSize    = GetDevicePathSize ((EFI_DEVICE_PATH_PROTOCOL *)CurrentDevicePath);
+          if ((CompareMem (DevicePath, CurrentDevicePath, DevicePathSize) == 0) && IsThisPackageList (Database, ConfigRequest)) {
+            DriverHandle = Database->DriverHandle;
+            HiiHandle    = Database->Handle;
+            HiiConfigRoutingCacheInsert (Private, ConfigRequest, Database);
+            break;
+          }
         }
       }
     }
@@ -5690,19 +5855,25 @@ HiiConfigRoutingRouteConfig (
     // Find driver which matches the routing data.
     //
     DriverHandle = NULL;
-    for (Link = Private->DatabaseList.ForwardLink;
-         Link != &Private->DatabaseList;
-         Link = Link->ForwardLink
-         )
-    {
-      Database = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
-
-      if ((DevicePathPkg = Database->PackageList->DevicePathPkg) != NULL) {
-        CurrentDevicePath = DevicePathPkg + sizeof (EFI_HII_PACKAGE_HEADER);
-        DevicePathSize    = GetDevicePathSize ((EFI_DEVICE_PATH_PROTOCOL *)CurrentDevicePath);
-        if ((CompareMem (DevicePath, CurrentDevicePath, DevicePathSize) == 0) && IsThisPackageList (Database, ConfigResp)) {
-          DriverHandle = Database->DriverHandle;
-          break;
+    Database     = HiiConfigRoutingCacheLookup (Private, ConfigResp);
+    if (Database != NULL) {
+      DriverHandle = Database->DriverHandle;
+    } else {
+      for (Link = Private->DatabaseList.ForwardLink;
+           Link != &Private->DatabaseList;
+           Link = Link->ForwardLink
+           )
+      {
+        Database = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+
+        if ((DevicePathPkg = Database->PackageList->DevicePathPkg) != NULL) {
+          CurrentDevicePath = DevicePathPkg + sizeof (EFI_HII_PACKAGE_HEADER);
+          DevicePathSize    = GetDevicePathSize ((EFI_DEVICE_PATH_PROTOCOL *)CurrentDevicePath);
+          if ((CompareMem (DevicePath, CurrentDevicePath, DevicePathSize) == 0) && IsThisPackageList (Database, ConfigResp)) {
+            DriverHandle = Database->DriverHandle;
+            HiiConfigRoutingCacheInsert (Private, ConfigResp, Database);
+            break;
+          }
         }
       }
     }
@@ -2591,6 +2591,7 @@ RemoveSimpleFontPackages (
     }
 
     RemoveEntryList (&Package->SimpleFontEntry);
+    HiiSimpleGlyphCacheFlush (Private);
     PackageList->PackageListHdr.PackageLength -= Package->SimpleFontPkgHdr->Header.Length;
     FreePool (Package->SimpleFontPkgHdr);
     FreePool (Package);
@@ -3261,6 +3262,8 @@ AddPackages (
           return Status;
         }
 
+        HiiSimpleGlyphCacheFlush (Private);
+
         Status = InvokeRegisteredFunction (
                    Private,
                    NotifyType,
@@ -3769,6 +3772,11 @@ HiiRemovePackageList (
 
   Private = HII_DATABASE_DATABASE_PRIVATE_DATA_FROM_THIS (This);
 
+  //
+  // The package list may be the one a cached <ConfigHdr> is routed to.
+  //
+  HiiConfigRoutingCacheFlush (Private);
+
   //
   // Get the packagelist to be removed.
   //
@@ -3929,6 +3937,12 @@ HiiUpdatePackageList (
   Status = EFI_SUCCESS;
 
   EfiAcquireLock (&mHiiDatabaseLock);
+
+  //
+  // The form and device path packages routing is based on may be updated.
+  //
+  HiiConfigRoutingCacheFlush (Private);
+
   //
   // Get original packagelist to be updated
   //
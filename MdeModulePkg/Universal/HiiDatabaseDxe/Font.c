@@ -127,6 +127,104 @@ GetCell (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Remove all the simple font glyph locations cached by Font.
+  It must be called whenever a simple font package is added or removed.
+
+  @param  Private                Hii database private structure.
+
+**/
+VOID
+HiiSimpleGlyphCacheFlush (
+  IN HII_DATABASE_PRIVATE_DATA  *Private
+  )
+{
+  ZeroMem (Private->SimpleGlyphCache, sizeof (Private->SimpleGlyphCache));
+}
+
+/**
+  Find the narrow or wide glyph of a character in the simple font packages.
+
+  The first glyph found walking the package lists in the database order is
+  returned. Its location is cached so that drawing the same character again
+  does not scan all the simple font packages.
+
+  This is a internal function.
+
+  @param  Private                 HII database driver private data.
+  @param  Char                    Character to retrieve.
+  @param  IsWide                  Output TRUE if the glyph is an EFI_WIDE_GLYPH,
+                                  FALSE if it is an EFI_NARROW_GLYPH.
+
+  @return Pointer to the glyph in the simple font package, or NULL if not found.
+
+**/
+VOID *
+FindSimpleFontGlyph (
+  IN  HII_DATABASE_PRIVATE_DATA  *Private,
+  IN  CHAR16                     Char,
+  OUT BOOLEAN                    *IsWide
+  )
+{
+  HII_SIMPLE_GLYPH_CACHE_ENTRY      *Entry;
+  HII_DATABASE_RECORD               *Node;
+  LIST_ENTRY                        *Link;
+  HII_SIMPLE_FONT_PACKAGE_INSTANCE  *SimpleFont;
+  LIST_ENTRY                        *Link1;
+  UINT16                            Index;
+  CHAR16                            UnicodeWeight;
+  EFI_NARROW_GLYPH                  *NarrowPtr;
+  EFI_WIDE_GLYPH                    *WidePtr;
+
+  Entry = &Private->SimpleGlyphCache[Char % HII_SIMPLE_GLYPH_CACHE_SIZE];
+  if ((Entry->Glyph != NULL) && (Entry->Char == Char)) {
+    *IsWide = Entry->IsWide;
+    return Entry->Glyph;
+  }
+
+  for (Link = Private->DatabaseList.ForwardLink; Link != &Private->DatabaseList; Link = Link->ForwardLink) {
+    Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+    for (Link1 = Node->PackageList->SimpleFontPkgHdr.ForwardLink;
+         Link1 != &Node->PackageList->SimpleFontPkgHdr;
+         Link1 = Link1->ForwardLink
+         )
+    {
+      SimpleFont = CR (Link1, HII_SIMPLE_FONT_PACKAGE_INSTANCE, SimpleFontEntry, HII_S_FONT_PACKAGE_SIGNATURE);
+      //
+      // Search the narrow glyph array
+      //
+      NarrowPtr = (EFI_NARROW_GLYPH *)((UINT8 *)(SimpleFont->SimpleFontPkgHdr) + sizeof (EFI_HII_SIMPLE_FONT_PACKAGE_HDR));
+      for (Index = 0; Index < SimpleFont->SimpleFontPkgHdr->NumberOfNarrowGlyphs; Index++) {
+        CopyMem (&UnicodeWeight, &NarrowPtr[Index].UnicodeWeight, sizeof (CHAR16));
+        if (UnicodeWeight == Char) {
+          Entry->Char   = Char;
+          Entry->IsWide = FALSE;
+          Entry->Glyph  = NarrowPtr + Index;
+          *IsWide       = FALSE;
+          return Entry->Glyph;
+        }
+      }
+
+      //
+      // Search the wide glyph array
+      //
+      WidePtr = (EFI_WIDE_GLYPH *)(NarrowPtr + SimpleFont->SimpleFontPkgHdr->NumberOfNarrowGlyphs);
+      for (Index = 0; Index < SimpleFont->SimpleFontPkgHdr->NumberOfWideGlyphs; Index++) {
+        CopyMem (&UnicodeWeight, &WidePtr[Index].UnicodeWeight, sizeof (CHAR16));
+        if (UnicodeWeight == Char) {
+          Entry->Char   = Char;
+          Entry->IsWide = TRUE;
+          Entry->Glyph  = WidePtr + Index;
+          *IsWide       = TRUE;
+          return Entry->Glyph;
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
 /**
   Convert the glyph for a single character into a bitmap.
 
@@ -157,17 +255,11 @@ GetGlyphBuffer (
   OUT UINT8                      *Attributes OPTIONAL
   )
 {
-  HII_DATABASE_RECORD               *Node;
-  LIST_ENTRY                        *Link;
-  HII_SIMPLE_FONT_PACKAGE_INSTANCE  *SimpleFont;
-  LIST_ENTRY                        *Link1;
-  UINT16                            Index;
-  EFI_NARROW_GLYPH                  Narrow;
-  EFI_WIDE_GLYPH                    Wide;
-  HII_GLOBAL_FONT_INFO              *GlobalFont;
-  UINTN                             HeaderSize;
-  EFI_NARROW_GLYPH                  *NarrowPtr;
-  EFI_WIDE_GLYPH                    *WidePtr;
+  EFI_NARROW_GLYPH      Narrow;
+  EFI_WIDE_GLYPH        Wide;
+  HII_GLOBAL_FONT_INFO  *GlobalFont;
+  VOID                  *Glyph;
+  BOOLEAN               IsWide;
 
   if ((GlyphBuffer == NULL) || (Cell == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -195,70 +287,45 @@ GetGlyphBuffer (
     }
 
     return FindGlyphBlock (GlobalFont->FontPackage, Char, GlyphBuffer, Cell, NULL);
-  } else {
-    HeaderSize = sizeof (EFI_HII_SIMPLE_FONT_PACKAGE_HDR);
-
-    for (Link = Private->DatabaseList.ForwardLink; Link != &Private->DatabaseList; Link = Link->ForwardLink) {
-      Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
-      for (Link1 = Node->PackageList->SimpleFontPkgHdr.ForwardLink;
-           Link1 != &Node->PackageList->SimpleFontPkgHdr;
-           Link1 = Link1->ForwardLink
-           )
-      {
-        SimpleFont = CR (Link1, HII_SIMPLE_FONT_PACKAGE_INSTANCE, SimpleFontEntry, HII_S_FONT_PACKAGE_SIGNATURE);
-        //
-        // Search the narrow glyph array
-        //
-        NarrowPtr = (EFI_NARROW_GLYPH *)((UINT8 *)(SimpleFont->SimpleFontPkgHdr) + HeaderSize);
-        for (Index = 0; Index < SimpleFont->SimpleFontPkgHdr->NumberOfNarrowGlyphs; Index++) {
-          CopyMem (&Narrow, NarrowPtr + Index, sizeof (EFI_NARROW_GLYPH));
-          if (Narrow.UnicodeWeight == Char) {
-            *GlyphBuffer = (UINT8 *)AllocateZeroPool (EFI_GLYPH_HEIGHT);
-            if (*GlyphBuffer == NULL) {
-              return EFI_OUT_OF_RESOURCES;
-            }
-
-            Cell->Width    = EFI_GLYPH_WIDTH;
-            Cell->Height   = EFI_GLYPH_HEIGHT;
-            Cell->AdvanceX = Cell->Width;
-            CopyMem (*GlyphBuffer, Narrow.GlyphCol1, Cell->Height);
-            if (Attributes != NULL) {
-              *Attributes = (UINT8)(Narrow.Attributes | NARROW_GLYPH);
-            }
+  }
 
-            return EFI_SUCCESS;
-          }
-        }
+  Glyph = FindSimpleFontGlyph (Private, Char, &IsWide);
+  if (Glyph == NULL) {
+    return EFI_NOT_FOUND;
+  }
 
-        //
-        // Search the wide glyph array
-        //
-        WidePtr = (EFI_WIDE_GLYPH *)(NarrowPtr + SimpleFont->SimpleFontPkgHdr->NumberOfNarrowGlyphs);
-        for (Index = 0; Index < SimpleFont->SimpleFontPkgHdr->NumberOfWideGlyphs; Index++) {
-          CopyMem (&Wide, WidePtr + Index, sizeof (EFI_WIDE_GLYPH));
-          if (Wide.UnicodeWeight == Char) {
-            *GlyphBuffer = (UINT8 *)AllocateZeroPool (EFI_GLYPH_HEIGHT * 2);
-            if (*GlyphBuffer == NULL) {
-              return EFI_OUT_OF_RESOURCES;
-            }
+  if (!IsWide) {
+    CopyMem (&Narrow, Glyph, sizeof (EFI_NARROW_GLYPH));
+    *GlyphBuffer = (UINT8 *)AllocateZeroPool (EFI_GLYPH_HEIGHT);
+    if (*GlyphBuffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
 
-            Cell->Width    = EFI_GLYPH_WIDTH * 2;
-            Cell->Height   = EFI_GLYPH_HEIGHT;
-            Cell->AdvanceX = Cell->Width;
-            CopyMem (*GlyphBuffer, Wide.GlyphCol1, EFI_GLYPH_HEIGHT);
-            CopyMem (*GlyphBuffer + EFI_GLYPH_HEIGHT, Wide.GlyphCol2, EFI_GLYPH_HEIGHT);
-            if (Attributes != NULL) {
-              *Attributes = (UINT8)(Wide.Attributes | EFI_GLYPH_WIDE);
-            }
+    Cell->Width    = EFI_GLYPH_WIDTH;
+    Cell->Height   = EFI_GLYPH_HEIGHT;
+    Cell->AdvanceX = Cell->Width;
+    CopyMem (*GlyphBuffer, Narrow.GlyphCol1, Cell->Height);
+    if (Attributes != NULL) {
+      *Attributes = (UINT8)(Narrow.Attributes | NARROW_GLYPH);
+    }
+  } else {
+    CopyMem (&Wide, Glyph, sizeof (EFI_WIDE_GLYPH));
+    *GlyphBuffer = (UINT8 *)AllocateZeroPool (EFI_GLYPH_HEIGHT * 2);
+    if (*GlyphBuffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
 
-            return EFI_SUCCESS;
-          }
-        }
-      }
+    Cell->Width    = EFI_GLYPH_WIDTH * 2;
+    Cell->Height   = EFI_GLYPH_HEIGHT;
+    Cell->AdvanceX = Cell->Width;
+    CopyMem (*GlyphBuffer, Wide.GlyphCol1, EFI_GLYPH_HEIGHT);
+    CopyMem (*GlyphBuffer + EFI_GLYPH_HEIGHT, Wide.GlyphCol2, EFI_GLYPH_HEIGHT);
+    if (Attributes != NULL) {
+      *Attributes = (UINT8)(Wide.Attributes | EFI_GLYPH_WIDE);
     }
   }
 
-  return EFI_NOT_FOUND;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -288,6 +288,28 @@ typedef struct _HII_DATABASE_RECORD {
   LIST_ENTRY                            DatabaseEntry;
 } HII_DATABASE_RECORD;
 
+//
+// Number of <ConfigHdr> to package list mappings cached by ConfigRouting.
+//
+#define HII_CONFIG_ROUTING_CACHE_SIZE  64
+
+typedef struct {
+  EFI_STRING             ConfigHdr;
+  UINTN                  ConfigHdrLength;
+  HII_DATABASE_RECORD    *Database;
+} HII_CONFIG_ROUTING_CACHE_ENTRY;
+
+//
+// Number of characters whose simple font glyph location is cached by Font.
+//
+#define HII_SIMPLE_GLYPH_CACHE_SIZE  256
+
+typedef struct {
+  CHAR16     Char;
+  BOOLEAN    IsWide;
+  VOID       *Glyph;  // EFI_NARROW_GLYPH or EFI_WIDE_GLYPH, NULL if empty
+} HII_SIMPLE_GLYPH_CACHE_ENTRY;
+
 #define HII_DATABASE_NOTIFY_SIGNATURE  SIGNATURE_32 ('h','i','d','n')
 
 typedef struct _HII_DATABASE_NOTIFY {
@@ -319,6 +341,8 @@ typedef struct _HII_DATABASE_PRIVATE_DATA {
   UINTN                                  Attribute;    // default system color
   EFI_GUID                               CurrentLayoutGuid;
   EFI_HII_KEYBOARD_LAYOUT                *CurrentLayout;
+  HII_CONFIG_ROUTING_CACHE_ENTRY         ConfigRoutingCache[HII_CONFIG_ROUTING_CACHE_SIZE];
+  HII_SIMPLE_GLYPH_CACHE_ENTRY           SimpleGlyphCache[HII_SIMPLE_GLYPH_CACHE_SIZE];
 } HII_DATABASE_PRIVATE_DATA;
 
 #define HII_FONT_DATABASE_PRIVATE_DATA_FROM_THIS(a) \
@@ -405,6 +429,32 @@ GenerateSubStr (
   OUT EFI_STRING       *SubStr
   );
 
+/**
+  Remove all the <ConfigHdr> to package list mappings cached by ConfigRouting.
+  It must be called whenever a package list is updated or removed. Adding a
+  package list does not need it: only matches are cached, and a new package
+  list is appended behind the cached ones, so it cannot take precedence.
+
+  @param  Private                Hii database private structure.
+
+**/
+VOID
+HiiConfigRoutingCacheFlush (
+  IN HII_DATABASE_PRIVATE_DATA  *Private
+  );
+
+/**
+  Remove all the simple font glyph locations cached by Font.
+  It must be called whenever a simple font package is added or removed.
+
+  @param  Private                Hii database private structure.
+
+**/
+VOID
+HiiSimpleGlyphCacheFlush (
+  IN HII_DATABASE_PRIVATE_DATA  *Private
+  );
+
 /**
   This function checks whether a handle is a valid EFI_HII_HANDLE.
 
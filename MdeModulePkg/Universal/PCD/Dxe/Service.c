@@ -31,6 +31,11 @@ LIST_ENTRY  *mCallbackFnTable;
 EFI_GUID    **TmpTokenSpaceBuffer;
 UINTN       TmpTokenSpaceBufferCount;
 
+UINT32                  *mPeiSizeTableIndex  = NULL;
+UINT32                  *mDxeSizeTableIndex  = NULL;
+PCD_EX_TOKEN_MAP_ENTRY  *mExTokenMap         = NULL;
+UINTN                   mExTokenMapSlotCount = 0;
+
 UINTN             mPeiPcdDbSize    = 0;
 PEI_PCD_DATABASE  *mPeiPcdDbBinary = NULL;
 UINTN             mDxePcdDbSize    = 0;
@@ -950,6 +955,179 @@ BuildPcdDxeDataBase (
   for (Index = 0; Index + 1 < mPcdTotalTokenCount + 1; Index++) {
     InitializeListHead (&mCallbackFnTable[Index]);
   }
+
+  BuildPcdLookupTables ();
+}
+
+/**
+  Compute the hash table slot of a dynamic-ex PCD's {token space guid: token number}.
+
+  @param Guid            Token space guid for dynamic-ex PCD entry.
+  @param ExTokenNumber   Dynamic-ex PCD token number.
+
+  @return The first slot to probe in mExTokenMap.
+
+**/
+UINTN
+ExTokenMapHash (
+  IN CONST EFI_GUID  *Guid,
+  IN UINT32          ExTokenNumber
+  )
+{
+  UINT32  Hash;
+
+  Hash  = ReadUnaligned32 ((CONST UINT32 *)Guid) ^ ReadUnaligned32 ((CONST UINT32 *)Guid + 3);
+  Hash ^= ExTokenNumber * 0x9E3779B1;
+  Hash ^= Hash >> 16;
+
+  return (UINTN)Hash & (mExTokenMapSlotCount - 1);
+}
+
+/**
+  Insert the entries of a dynamic-ex mapping table into mExTokenMap.
+
+  Entries already present are kept, so the database inserted first wins, which
+  matches the lookup order of the table scan in GetExPcdTokenNumber().
+
+  @param ExMap           Dynamic-ex mapping table of the PCD database.
+  @param ExTokenCount    Number of entries in ExMap.
+  @param GuidTable       GUID table of the PCD database.
+
+**/
+VOID
+InsertExTokenMap (
+  IN DYNAMICEX_MAPPING  *ExMap,
+  IN UINTN              ExTokenCount,
+  IN EFI_GUID           *GuidTable
+  )
+{
+  UINTN           Index;
+  UINTN           Slot;
+  CONST EFI_GUID  *Guid;
+
+  for (Index = 0; Index < ExTokenCount; Index++) {
+    Guid = GuidTable + ExMap[Index].ExGuidIndex;
+    Slot = ExTokenMapHash (Guid, ExMap[Index].ExTokenNumber);
+    while (mExTokenMap[Slot].Guid != NULL) {
+      if ((mExTokenMap[Slot].ExTokenNumber == ExMap[Index].ExTokenNumber) &&
+          CompareGuid (mExTokenMap[Slot].Guid, Guid))
+      {
+        break;
+      }
+
+      Slot = (Slot + 1) & (mExTokenMapSlotCount - 1);
+    }
+
+    if (mExTokenMap[Slot].Guid == NULL) {
+      mExTokenMap[Slot].Guid          = Guid;
+      mExTokenMap[Slot].ExTokenNumber = ExMap[Index].ExTokenNumber;
+      mExTokenMap[Slot].TokenNumber   = ExMap[Index].TokenNumber;
+    }
+  }
+}
+
+/**
+  Build the size table index lookup for one PCD database.
+
+  @param IsPeiDb         If TRUE, build the table of the PEI PCD database,
+                         If FALSE, build the table of the DXE PCD database.
+
+  @return The allocated lookup table, or NULL if memory is not available.
+
+**/
+UINT32 *
+BuildSizeTableIndex (
+  IN BOOLEAN  IsPeiDb
+  )
+{
+  UINT32  *LocalTokenNumberTable;
+  UINT32  LocalTokenCount;
+  UINT32  *SizeTableIndex;
+  UINT32  SizeTableIdx;
+  UINTN   Index;
+
+  if (IsPeiDb) {
+    LocalTokenNumberTable = (UINT32 *)((UINT8 *)mPcdDatabase.PeiDb + mPcdDatabase.PeiDb->LocalTokenNumberTableOffset);
+    LocalTokenCount       = mPeiLocalTokenCount;
+  } else {
+    LocalTokenNumberTable = (UINT32 *)((UINT8 *)mPcdDatabase.DxeDb + mPcdDatabase.DxeDb->LocalTokenNumberTableOffset);
+    LocalTokenCount       = mDxeLocalTokenCount;
+  }
+
+  if (LocalTokenCount == 0) {
+    return NULL;
+  }
+
+  SizeTableIndex = AllocatePool (LocalTokenCount * sizeof (UINT32));
+  if (SizeTableIndex == NULL) {
+    return NULL;
+  }
+
+  //
+  // SizeTable only contains the MAX SIZE and the Current Size
+  // records of PCD_DATUM_TYPE_POINTER type PCD entries.
+  //
+  SizeTableIdx = 0;
+  for (Index = 0; Index < LocalTokenCount; Index++) {
+    SizeTableIndex[Index] = SizeTableIdx;
+    if ((LocalTokenNumberTable[Index] & PCD_DATUM_TYPE_ALL_SET) == PCD_DATUM_TYPE_POINTER) {
+      SizeTableIdx += 2;
+    }
+  }
+
+  return SizeTableIndex;
+}
+
+/**
+  Build the lookup tables used to speed up the PCD database accesses.
+
+  The size table index of each PCD entry and the Token Number of each dynamic-ex
+  PCD entry are computed once here, instead of scanning the local token number
+  table, the GUID table and the dynamic-ex mapping table on every access.
+  If memory is not available, the lookups fall back to the table scans.
+
+**/
+VOID
+BuildPcdLookupTables (
+  VOID
+  )
+{
+  UINTN  ExTokenCount;
+
+  if (!mPeiDatabaseEmpty) {
+    mPeiSizeTableIndex = BuildSizeTableIndex (TRUE);
+  }
+
+  mDxeSizeTableIndex = BuildSizeTableIndex (FALSE);
+
+  ExTokenCount = mPcdDatabase.PeiDb->ExTokenCount + mPcdDatabase.DxeDb->ExTokenCount;
+  if (ExTokenCount == 0) {
+    return;
+  }
+
+  //
+  // Keep the load factor of the open addressing table at or below one half.
+  //
+  mExTokenMapSlotCount = GetPowerOfTwo32 ((UINT32)ExTokenCount) << 2;
+  mExTokenMap          = AllocateZeroPool (mExTokenMapSlotCount * sizeof (PCD_EX_TOKEN_MAP_ENTRY));
+  if (mExTokenMap == NULL) {
+    mExTokenMapSlotCount = 0;
+    return;
+  }
+
+  if (!mPeiDatabaseEmpty) {
+    InsertExTokenMap (
+      (DYNAMICEX_MAPPING *)((UINT8 *)mPcdDatabase.PeiDb + mPcdDatabase.PeiDb->ExMapTableOffset),
+      mPcdDatabase.PeiDb->ExTokenCount,
+      (EFI_GUID *)((UINT8 *)mPcdDatabase.PeiDb + mPcdDatabase.PeiDb->GuidTableOffset)
+      );
+  }
+
+  InsertExTokenMap (
+    (DYNAMICEX_MAPPING *)((UINT8 *)mPcdDatabase.DxeDb + mPcdDatabase.DxeDb->ExMapTableOffset),
+    mPcdDatabase.DxeDb->ExTokenCount,
+    (EFI_GUID *)((UINT8 *)mPcdDatabase.DxeDb + mPcdDatabase.DxeDb->GuidTableOffset)
+    );
 }
 
 /**
@@ -1592,6 +1770,20 @@ GetExPcdTokenNumber (
   EFI_GUID           *GuidTable;
   EFI_GUID           *MatchGuid;
   UINTN              MatchGuidIdx;
+  UINTN              Slot;
+
+  if (mExTokenMap != NULL) {
+    Slot = ExTokenMapHash (Guid, ExTokenNumber);
+    while (mExTokenMap[Slot].Guid != NULL) {
+      if ((mExTokenMap[Slot].ExTokenNumber == ExTokenNumber) &&
+          CompareGuid (mExTokenMap[Slot].Guid, Guid))
+      {
+        return mExTokenMap[Slot].TokenNumber;
+      }
+
+      Slot = (Slot + 1) & (mExTokenMapSlotCount - 1);
+    }
+  }
 
   if (!mPeiDatabaseEmpty) {
     ExMap     = (DYNAMICEX_MAPPING *)((UINT8 *)mPcdDatabase.PeiDb + mPcdDatabase.PeiDb->ExMapTableOffset);
@@ -1658,6 +1850,14 @@ GetSizeTableIndex (
   UINTN   Index;
   UINTN   SizeTableIdx;
 
+  if (IsPeiDb && (mPeiSizeTableIndex != NULL)) {
+    return mPeiSizeTableIndex[LocalTokenNumberTableIdx];
+  }
+
+  if (!IsPeiDb && (mDxeSizeTableIndex != NULL)) {
+    return mDxeSizeTableIndex[LocalTokenNumberTableIdx];
+  }
+
   if (IsPeiDb) {
     LocalTokenNumberTable = (UINT32 *)((UINT8 *)mPcdDatabase.PeiDb + mPcdDatabase.PeiDb->LocalTokenNumberTableOffset);
   } else {
@@ -44,6 +44,17 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 extern UINTN  mVpdBaseAddress;
 
+//
+// Entry of the hash table that maps a dynamic-ex PCD's
+// {token space guid: token number} to its Token Number.
+// A NULL Guid marks an empty slot.
+//
+typedef struct {
+  CONST EFI_GUID    *Guid;
+  UINT32            ExTokenNumber;
+  UINT32            TokenNumber;
+} PCD_EX_TOKEN_MAP_ENTRY;
+
 /**
   Retrieve additional information associated with a PCD token in the default token space.
 
@@ -1073,6 +1084,20 @@ GetExPcdTokenNumber (
   IN UINT32          ExTokenNumber
   );
 
+/**
+  Build the lookup tables used to speed up the PCD database accesses.
+
+  The size table index of each PCD entry and the Token Number of each dynamic-ex
+  PCD entry are computed once here, instead of scanning the local token number
+  table, the GUID table and the dynamic-ex mapping table on every access.
+  If memory is not available, the lookups fall back to the table scans.
+
+**/
+VOID
+BuildPcdLookupTables (
+  VOID
+  );
+
 /**
   Get next token number in given token space.
 
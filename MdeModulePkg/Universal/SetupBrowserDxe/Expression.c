@@ -846,6 +846,25 @@ IdToQuestion (
 {
   LIST_ENTRY              *Link;
   FORM_BROWSER_STATEMENT  *Question;
+  QUESTION_ID_MAP_ENTRY   *Entry;
+
+  //
+  // Look up the first Question with this QuestionId in the formset.
+  // If it belongs to the form, it is also the first one in the form scope.
+  //
+  Entry = NULL;
+  if ((FormSet->QuestionIdMap != NULL) && (QuestionId != 0)) {
+    Entry = &FormSet->QuestionIdMap[QuestionId & (FormSet->QuestionIdMapSize - 1)];
+    while ((Entry->QuestionId != 0) && (Entry->QuestionId != QuestionId)) {
+      Entry = FormSet->QuestionIdMap + ((Entry - FormSet->QuestionIdMap + 1) & (FormSet->QuestionIdMapSize - 1));
+    }
+
+    if (Entry->QuestionId == 0) {
+      Entry = NULL;
+    } else if (Entry->Form == Form) {
+      return Entry->Question;
+    }
+  }
 
   //
   // Search in the form scope first
@@ -858,6 +877,23 @@ IdToQuestion (
   //
   // Search in the formset scope
   //
+  if (FormSet->QuestionIdMap != NULL) {
+    if (Entry == NULL) {
+      return NULL;
+    }
+
+    Question = Entry->Question;
+    //
+    // EFI variable storage may be updated by Callback() asynchronous,
+    // to keep synchronous, always reload the Question Value.
+    //
+    if (Question->Storage->Type == EFI_HII_VARSTORE_EFI_VARIABLE) {
+      GetQuestionValue (FormSet, Entry->Form, Question, GetSetValueWithHiiDriver);
+    }
+
+    return Question;
+  }
+
   Link = GetFirstNode (&FormSet->FormListHead);
   while (!IsNull (&FormSet->FormListHead, Link)) {
     Form = FORM_BROWSER_FORM_FROM_LINK (Link);
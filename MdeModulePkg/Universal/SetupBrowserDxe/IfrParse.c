@@ -1021,9 +1021,92 @@ DestroyFormSet (
     FreePool (FormSet->ExpressionBuffer);
   }
 
+  if (FormSet->QuestionIdMap != NULL) {
+    FreePool (FormSet->QuestionIdMap);
+  }
+
   FreePool (FormSet);
 }
 
+/**
+  Build the map from QuestionId to Question used by IdToQuestion().
+  If memory is not available, the map is not built and IdToQuestion()
+  searches the Forms instead.
+
+  @param  FormSet                Pointer of the FormSet data structure.
+
+**/
+VOID
+BuildQuestionIdMap (
+  IN OUT FORM_BROWSER_FORMSET  *FormSet
+  )
+{
+  LIST_ENTRY              *FormLink;
+  LIST_ENTRY              *Link;
+  FORM_BROWSER_FORM       *Form;
+  FORM_BROWSER_STATEMENT  *Question;
+  UINTN                   NumberOfQuestion;
+  UINTN                   Index;
+
+  NumberOfQuestion = 0;
+  FormLink         = GetFirstNode (&FormSet->FormListHead);
+  while (!IsNull (&FormSet->FormListHead, FormLink)) {
+    Form = FORM_BROWSER_FORM_FROM_LINK (FormLink);
+    Link = GetFirstNode (&Form->StatementListHead);
+    while (!IsNull (&Form->StatementListHead, Link)) {
+      NumberOfQuestion++;
+      Link = GetNextNode (&Form->StatementListHead, Link);
+    }
+
+    FormLink = GetNextNode (&FormSet->FormListHead, FormLink);
+  }
+
+  if (NumberOfQuestion == 0) {
+    return;
+  }
+
+  //
+  // Keep at least half of the entries empty to bound the probe sequences.
+  //
+  FormSet->QuestionIdMapSize = GetPowerOfTwo64 (NumberOfQuestion) << 2;
+  FormSet->QuestionIdMap     = AllocateZeroPool (FormSet->QuestionIdMapSize * sizeof (QUESTION_ID_MAP_ENTRY));
+  if (FormSet->QuestionIdMap == NULL) {
+    FormSet->QuestionIdMapSize = 0;
+    return;
+  }
+
+  //
+  // Only the first Question in Form list order is recorded for a QuestionId,
+  // which is the one found by searching the Forms.
+  //
+  FormLink = GetFirstNode (&FormSet->FormListHead);
+  while (!IsNull (&FormSet->FormListHead, FormLink)) {
+    Form = FORM_BROWSER_FORM_FROM_LINK (FormLink);
+    Link = GetFirstNode (&Form->StatementListHead);
+    while (!IsNull (&Form->StatementListHead, Link)) {
+      Question = FORM_BROWSER_STATEMENT_FROM_LINK (Link);
+      if (Question->QuestionId != 0) {
+        Index = Question->QuestionId & (FormSet->QuestionIdMapSize - 1);
+        while ((FormSet->QuestionIdMap[Index].QuestionId != 0) &&
+               (FormSet->QuestionIdMap[Index].QuestionId != Question->QuestionId))
+        {
+          Index = (Index + 1) & (FormSet->QuestionIdMapSize - 1);
+        }
+
+        if (FormSet->QuestionIdMap[Index].QuestionId == 0) {
+          FormSet->QuestionIdMap[Index].QuestionId = Question->QuestionId;
+          FormSet->QuestionIdMap[Index].Question   = Question;
+          FormSet->QuestionIdMap[Index].Form       = Form;
+        }
+      }
+
+      Link = GetNextNode (&Form->StatementListHead, Link);
+    }
+
+    FormLink = GetNextNode (&FormSet->FormListHead, FormLink);
+  }
+}
+
 /**
   Tell whether this Operand is an Expression OpCode or not
 
@@ -2746,5 +2829,7 @@ ParseOpCodes (
     }
   }
 
+  BuildQuestionIdMap (FormSet);
+
   return EFI_SUCCESS;
 }
@@ -428,6 +428,12 @@ typedef struct {
 
 #define FORMSET_DEFAULTSTORE_FROM_LINK(a)  CR (a, FORMSET_DEFAULTSTORE, Link, FORMSET_DEFAULTSTORE_SIGNATURE)
 
+typedef struct {
+  UINT16                    QuestionId; // Zero if this entry is empty
+  FORM_BROWSER_STATEMENT    *Question;
+  FORM_BROWSER_FORM         *Form;
+} QUESTION_ID_MAP_ENTRY;
+
 #define FORM_BROWSER_FORMSET_SIGNATURE  SIGNATURE_32 ('F', 'B', 'F', 'S')
 
 typedef struct {
@@ -465,6 +471,9 @@ typedef struct {
   LIST_ENTRY                        DefaultStoreListHead;    // DefaultStore list (FORMSET_DEFAULTSTORE)
   LIST_ENTRY                        FormListHead;            // Form list (FORM_BROWSER_FORM)
   LIST_ENTRY                        ExpressionListHead;      // List of Expressions (FORM_EXPRESSION)
+
+  QUESTION_ID_MAP_ENTRY             *QuestionIdMap;     // Hash of QuestionId to its first Question in the Form list
+  UINTN                             QuestionIdMapSize;  // Number of entries in QuestionIdMap, a power of two
 } FORM_BROWSER_FORMSET;
 #define FORM_BROWSER_FORMSET_FROM_LINK(a)  CR (a, FORM_BROWSER_FORMSET, Link, FORM_BROWSER_FORMSET_SIGNATURE)
 
@@ -619,6 +628,19 @@ ParseOpCodes (
   IN FORM_BROWSER_FORMSET  *FormSet
   );
 
+/**
+  Build the map from QuestionId to Question used by IdToQuestion().
+  If memory is not available, the map is not built and IdToQuestion()
+  searches the Forms instead.
+
+  @param  FormSet                Pointer of the FormSet data structure.
+
+**/
+VOID
+BuildQuestionIdMap (
+  IN OUT FORM_BROWSER_FORMSET  *FormSet
+  );
+
 /**
   Free resources allocated for a FormSet.
 